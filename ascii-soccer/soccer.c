@@ -61,11 +61,40 @@ int	player_x[8], player_y[8];
 int	field[MAX_X][MAX_Y];
 int	display = 1; /* indicates whether or not to display stuff */
 int	points = 7; /* How many points til a win ? */
+int	frame_rate = 30; /* How often the screen is updated per second (0 = always) */
+struct timeval	last_render; /* When was the screen updated the last time ? */
 
 extern	int	opterr;
 extern	char	*optarg;
 
 
+/******************************************************************
+
+	render() 
+
+	Send the changes drawn to the terminal.  mvaddch() only
+	changes curses' back buffer, so all moves since the last
+	call are sent at once.  Unless forced, this happens at
+	most frame_rate times per second, so the display does not
+	slow down the simulation.
+
+******************************************************************/
+void render(int force)
+{
+struct timeval	now;
+
+if (!display) return;
+gettimeofday(&now, NULL);
+if (!force && frame_rate > 0 &&
+	(now.tv_sec - last_render.tv_sec) * 1000000L
+	+ (now.tv_usec - last_render.tv_usec) < 1000000L / frame_rate)
+	return;
+last_render = now;
+wnoutrefresh(game_win);
+doupdate();
+}
+
+
 /******************************************************************
 
 	report_score() 
@@ -81,7 +110,7 @@ sprintf(score_line,
 if (display) mvaddstr(MAX_Y, 0, score_line);
 sprintf(score_line, "ASCII=Soccer=v2.0====(q)uit====(s)lower====(f)aster");
 if (display) mvaddstr(0, 0, score_line);
-if (display) wrefresh(game_win);
+render(1);
 }
 
 
@@ -103,7 +132,6 @@ do
 while (field[ball_x][ball_y] != EMPTY);
 field[ball_x][ball_y] = BALL;
 if (display) mvaddch(ball_y, ball_x, 'O');
-if (display) wrefresh(game_win);
 }
 
 
@@ -226,7 +254,7 @@ for(i=0; i<MAX_X; i++)
 	}
 
 /*--- Refresh the screen ---*/
-if (display) wrefresh(game_win);
+render(1);
 }
 		
     
@@ -271,7 +299,7 @@ cur = 0;
  * Scan the ole arglist
  */
 opterr = 0;
-while ((c = getopt(argc, argv, "dg:s:p:")) != -1)
+while ((c = getopt(argc, argv, "dg:s:p:r:")) != -1)
 	{
       	switch (c)
       		{
@@ -296,6 +324,15 @@ while ((c = getopt(argc, argv, "dg:s:p:")) != -1)
                   		fprintf(stderr, "Points must be > 0 (%s)\n", optarg);
             		}
             		break;
+		case 'r':
+            		{
+               		int i;
+               		if (sscanf(optarg, "%d", &i) == 0 || i < 0)
+                  		fprintf(stderr, "Error reading frame rate! (%s)\n", optarg);
+               		else
+				frame_rate = i;
+            		}
+            		break;
 
 		default : break;
 		}
@@ -632,7 +669,7 @@ while (game_over != 1)
 			{
 			if (display) mvaddch(player_y[cur], player_x[cur], '>');
 			}
-		if (display) wrefresh(game_win);
+		render(0);
 
 		/*
 		 * Check for a score.
@@ -736,7 +773,7 @@ while (game_over != 1)
 			overall_count = 0;
 			EASTlost_point(); /* punish teams */
 			WESTlost_point();
-			if (display) wrefresh(game_win);
+			render(0);
 			}
 		}
 
@@ -0,0 +1,141 @@
+/**
+ * This program checks that large option arguments are never copied between
+ * the call site and the option body, neither if they have a default value
+ * nor if they do not, and neither with nor without an activation graph. It
+ * passes a path of a million points to several options and counts how often
+ * it is copied. It also measures how long a frame takes compared to copying
+ * the path once.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <Cabsl.h>
+
+/** A path that counts how often paths are copied. */
+struct Path
+{
+  static inline unsigned copies = 0; /**< The number of copies made so far. */
+
+  std::vector<double> points; /**< The coordinates of the points. */
+
+  Path() = default;
+  Path(std::vector<double> points) : points(std::move(points)) {}
+  Path(const Path& other) : points(other.points) {++copies;}
+  Path(Path&&) = default;
+  Path& operator=(const Path& other) {points = other.points; ++copies; return *this;}
+  Path& operator=(Path&&) = default;
+
+  bool operator==(const Path& other) const {return points == other.points;}
+};
+
+/** Paths are shown by their number of points in the activation graph. */
+std::ostream& operator<<(std::ostream& stream, const Path& path)
+{
+  return stream << path.points.size() << " points";
+}
+
+class Behavior : public cabsl::Cabsl<Behavior>
+{
+public:
+  Path path; /**< The path passed to all options. */
+  double length = 0; /**< The sum of the first coordinates seen by the options. */
+
+  Behavior(cabsl::ActivationGraph* activationGraph = nullptr) :
+    Cabsl(activationGraph)
+  {
+  }
+
+  option(root)
+  {
+    initial_state(follow)
+    {
+      action
+      {
+        follow_path({.path = path});
+        follow_path_with_default({.path = path});
+        follow_path_with_default();
+        follow_path_with_vars({.path = path, .name = "path"});
+      }
+    }
+  }
+
+  option(follow_path, args((Path) path))
+  {
+    initial_state(follow)
+    {
+      action
+      {
+        length += path.points[0];
+      }
+    }
+  }
+
+  option(follow_path_with_default, args((Path)(Path({1.0})) path))
+  {
+    initial_state(follow)
+    {
+      action
+      {
+        length += path.points[0];
+      }
+    }
+  }
+
+  option(follow_path_with_vars, args((Path) path, (std::string)("unnamed") name), vars((int)(0) counter))
+  {
+    initial_state(follow)
+    {
+      action
+      {
+        ++counter;
+        length += path.points[0] + static_cast<double>(name.size());
+      }
+    }
+  }
+};
+
+/**
+ * Measures how long it takes to execute the behavior for a number of frames.
+ * @param behavior The behavior.
+ * @param frames The number of frames.
+ * @return The average time per frame in ns.
+ */
+static double measure(Behavior& behavior, unsigned frames)
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(unsigned frame = 0; frame < frames; ++frame)
+  {
+    behavior.beginFrame(frame * 10);
+    behavior.root();
+    behavior.endFrame();
+  }
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / frames;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned frames = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 100000;
+
+  cabsl::ActivationGraph activationGraph;
+  Behavior withoutGraph;
+  Behavior withGraph(&activationGraph);
+  withoutGraph.path = withGraph.path = Path(std::vector<double>(1000000, 1.0));
+  Path::copies = 0;
+
+  const double timeWithoutGraph = measure(withoutGraph, frames);
+  const double timeWithGraph = measure(withGraph, frames);
+  const unsigned copies = Path::copies;
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const Path copy = withoutGraph.path;
+  const double copyTime = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+  std::cout << "path: " << copy.points.size() << " points, copying it takes " << copyTime << " ns\n"
+            << "without activation graph: " << timeWithoutGraph << " ns/frame\n"
+            << "with activation graph:    " << timeWithGraph << " ns/frame\n"
+            << "copies of the path made by " << 2 * frames << " frames: " << copies << "\n";
+  return copies == 0 && withoutGraph.length == withGraph.length ? EXIT_SUCCESS : EXIT_FAILURE;
+}
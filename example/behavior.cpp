@@ -15,17 +15,73 @@
  * @author Thomas Röfer
  */
 
+#include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include "behavior.h"
 
-int Behavior::ball_x = 0;
-int Behavior::ball_y = 0;
-int Behavior::team_x[4];
-int Behavior::team_y[4];
-Behavior::Action Behavior::team_ball_direction[4];
+thread_local int Behavior::ball_x = 0;
+thread_local int Behavior::ball_y = 0;
+thread_local int Behavior::team_x[4];
+thread_local int Behavior::team_y[4];
+thread_local Behavior::Action Behavior::team_ball_direction[4];
+cabsl::Recorder<Frame>* Behavior::recorder = nullptr;
 
 Behavior::Action Behavior::execute(int local_area[9], Action ball_direction, int x, int y) {
 
+  // record the inputs and the state shared by the team
+  Frame frame;
+  if (recorder) {
+    std::memset(&frame, 0, sizeof(frame)); // also clear the padding that is written to the log
+    frame.player_number = static_cast<std::int8_t>(player_number);
+    for (int i = 0; i < 9; ++i)
+      frame.local_area[i] = static_cast<std::int8_t>(local_area[i]);
+    frame.ball_direction = static_cast<std::int8_t>(ball_direction);
+    frame.x = static_cast<std::int8_t>(x);
+    frame.y = static_cast<std::int8_t>(y);
+    for (int i = 0; i < 4; ++i) {
+      frame.team_ball_direction[i] = static_cast<std::int8_t>(team_ball_direction[i]);
+      frame.team_x[i] = static_cast<std::int8_t>(team_x[i]);
+      frame.team_y[i] = static_cast<std::int8_t>(team_y[i]);
+    }
+    frame.ball_x = static_cast<std::int8_t>(ball_x);
+    frame.ball_y = static_cast<std::int8_t>(ball_y);
+  }
+
+  const Action result = step(local_area, ball_direction, x, y);
+
+  // record the results
+  if (recorder) {
+    frame.next_action = static_cast<std::int8_t>(result);
+    frame.activation_graph = activationGraph.hash();
+    recorder->record(frame);
+  }
+
+  showActivationGraph();
+
+  return result;
+}
+
+Behavior::Action Behavior::replay(const Frame& frame) {
+
+  // restore the inputs and the state shared by the team
+  int local_area[9];
+  for (int i = 0; i < 9; ++i)
+    local_area[i] = frame.local_area[i];
+  for (int i = 0; i < 4; ++i) {
+    team_ball_direction[i] = static_cast<Action>(frame.team_ball_direction[i]);
+    team_x[i] = frame.team_x[i];
+    team_y[i] = frame.team_y[i];
+  }
+  ball_x = frame.ball_x;
+  ball_y = frame.ball_y;
+
+  return step(local_area, static_cast<Action>(frame.ball_direction), frame.x, frame.y);
+}
+
+Behavior::Action Behavior::step(int local_area[9], Action ball_direction, int x, int y) {
+
   // copy arguments
   std::memcpy(this->local_area, local_area, sizeof(this->local_area));
   this->ball_direction = team_ball_direction[player_number] = ball_direction;
@@ -39,8 +95,6 @@ Behavior::Action Behavior::execute(int local_area[9], Action ball_direction, int
   Cabsl<Behavior>::execute("play_soccer");
   endFrame();
 
-  showActivationGraph();
-
   return next_action;
 }
 
@@ -158,21 +212,55 @@ void Behavior::updateWorldState()
 
 void Behavior::showActivationGraph()
 {
-  if (!window)
+  if (!window) {
     window = subwin(stdscr, 14, 39, 25 + player_number / 2 * 15, player_number % 2 * 41);
-  wclear(window);
+    if (!window) // no display or the terminal is too small
+      return;
+    int height, width;
+    getmaxyx(window, height, width);
+    shown_lines.assign(height, std::string(width, ' '));
+    werase(window);
+  }
 
-  int y = 0;
+  // render the activation graph into lines of text
+  std::vector<std::string> lines(shown_lines.size(), std::string(shown_lines[0].size(), ' '));
+  size_t y = 0;
+  auto print = [&](size_t row, size_t column, const std::string& text) {
+    if (row < lines.size() && column < lines[row].size())
+      lines[row].replace(column, std::min(text.size(), lines[row].size() - column), text);
+  };
+  auto time = [](int time) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%4d", time);
+    return std::string(buffer);
+  };
   for(const cabsl::ActivationGraph::Node& activeOption : activationGraph.graph)
   {
-    mvwprintw(window, y, activeOption.depth - 1, "%s", activeOption.option.c_str());
-    mvwprintw(window, y++, 35, "%4d", activeOption.optionTime);
+    print(y, activeOption.depth - 1, activeOption.option);
+    print(y++, 35, time(activeOption.optionTime));
 
     for(const std::string& argument : activeOption.arguments)
-      mvwprintw(window, y++, activeOption.depth + 1, "%s", argument.c_str());
+      print(y++, activeOption.depth + 1, argument);
+
+    print(y, activeOption.depth + 1, "state = " + activeOption.state);
+    print(y++, 35, time(activeOption.stateTime));
+  }
 
-    mvwprintw(window, y, activeOption.depth + 1, "state = %s", activeOption.state.c_str());
-    mvwprintw(window, y++, 35, "%4d", activeOption.stateTime);
+  // only write the cells that differ from what is shown
+  for (y = 0; y < lines.size(); ++y) {
+    const std::string& line = lines[y];
+    std::string& shown_line = shown_lines[y];
+    size_t first = 0, last = line.size();
+    while (first < last && line[first] == shown_line[first])
+      ++first;
+    while (last > first && line[last - 1] == shown_line[last - 1])
+      --last;
+    if (first < last) {
+      mvwaddnstr(window, static_cast<int>(y), static_cast<int>(first), line.c_str() + first, static_cast<int>(last - first));
+      shown_line = line;
+    }
   }
-  wrefresh(window);
+
+  // copy the changes to the virtual screen, the terminal is updated once for the whole team
+  wnoutrefresh(window);
 }
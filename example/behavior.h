@@ -18,6 +18,8 @@
 #include <curses.h>
 #include <soccer.h>
 #include <Cabsl.h>
+#include <Recorder.h>
+#include "frame.h"
 
 // All actions are undefined to define an enum instead (not necessary, but nicer).
 #undef NW
@@ -42,14 +44,16 @@ public:
     NW, N, NE, W, PLAYER, E, SW, S, SE, KICK, DO_NOTHING
   };
 
+  static cabsl::Recorder<Frame>* recorder; /**< If set, all behavior steps are recorded. */
+
 protected:
   int local_area[9]; /**< The local area as passed by ascii soccer. */
   Action ball_direction; /**< The ball direction as passed by ascii soccer. */
   int x; /**< The player's x coordinate as passed by ascii soccer. */
   int y; /**< The player's y coordinate as passed by ascii soccer. */
 
-  static int ball_x; /**< A shared estimate of the ball's x coordinate. */
-  static int ball_y; /**< A shared estimate of the ball's y coordinate. */
+  static thread_local int ball_x; /**< A shared estimate of the ball's x coordinate. */
+  static thread_local int ball_y; /**< A shared estimate of the ball's y coordinate. */
   double ball_distance; /**< The player's distance to the estimated ball. */
   Action ball_local_direction; /**< The direction to the ball if it is in the local area. Otherwise DO_NOTHING. */
   int most_westerly_teammate_x; /**< The x coordinate of the westmost player. */
@@ -60,18 +64,34 @@ protected:
 
 private:
   // The following members are helpers not directly used by the behavior.
+  // The state shared by the team is thread-local, so that several teams can be replayed in parallel.
   unsigned frame_counter = 0; /**< Frame counter. Is increased in each frame. */
   int player_number; /**< The number of this player [0..3]. */
-  static Action team_ball_direction[4]; /**< The shared ball directions of all players. */
-  static int team_x[4]; /**< The shared x coordinates of all players. */
-  static int team_y[4]; /**< The shared y coordinates of all players. */
+  static thread_local Action team_ball_direction[4]; /**< The shared ball directions of all players. */
+  static thread_local int team_x[4]; /**< The shared x coordinates of all players. */
+  static thread_local int team_y[4]; /**< The shared y coordinates of all players. */
   cabsl::ActivationGraph activationGraph; /**< The activation graph used for debugging. */
   WINDOW* window = nullptr; /**< The window in which the activation graph is shown. */
+  std::vector<std::string> shown_lines; /**< The lines currently shown in the window. */
 
   /** Update the world state, i.e. the input symbols. */
   void updateWorldState();
+
+  /**
+   * Execute a single behavior step without showing it.
+   * @param local_area The local area as passed by ascii soccer.
+   * @param ball_direction The ball direction as passed by ascii soccer.
+   * @param x The player's x coordinate as passed by ascii soccer.
+   * @param y The player's y coordinate as passed by ascii soccer.
+   * @return The next action to perform.
+   */
+  Action step(int local_area[9], Action ball_direction, int x, int y);
   
-  /** Shows the activation graph below the field. */
+  /**
+   * Shows the activation graph below the field. Only the cells that changed
+   * since the previous frame are written. The terminal is not updated here,
+   * but together with the field by ascii soccer at a fixed frame rate.
+   */
   void showActivationGraph();
 
 public:
@@ -92,6 +112,21 @@ public:
    * @return The next action to perform.
    */
   Action execute(int local_area[9], Action ball_direction, int x, int y);
+
+  /**
+   * Execute a recorded behavior step again. The state shared by the team is
+   * set as it was recorded.
+   * @param frame The step recorded.
+   * @return The next action to perform. It can be compared to the one recorded,
+   *         as can the activation graph.
+   */
+  Action replay(const Frame& frame);
+
+  /**
+   * Return the activation graph of the last behavior step.
+   * @return The activation graph.
+   */
+  const cabsl::ActivationGraph& get_activation_graph() const {return activationGraph;}
 };
 
 /**
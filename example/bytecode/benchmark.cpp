@@ -0,0 +1,224 @@
+/**
+ * This program compares the execution of a behavior compiled natively with
+ * its execution by the bytecode interpreter. It first checks that both
+ * produce the same activation graphs and outputs in each frame, both with
+ * and without filtering the activation graphs, and then measures how long
+ * each of them needs to execute a number of frames. It also checks that
+ * programs survive writing and reading them and are verified correctly.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <Bytecode.h>
+#include <Cabsl.h>
+
+/** The symbols shared by both implementations of the behavior. */
+struct Symbols
+{
+  bool active = false;
+  double ballDistance = 0;
+  double ballAngle = 0;
+  bool ballSeen = false;
+  double speed = 0;
+  double turn = 0;
+  bool kick = false;
+  int kicks = 0;
+
+  /**
+   * Simulates the world, i.e. sets the inputs for a frame.
+   * @param frame The number of the frame.
+   */
+  void update(unsigned frame)
+  {
+    const unsigned hash = frame * 2654435761u;
+    active = frame % 4000 >= 100;
+    ballSeen = hash % 37 != 0;
+    ballDistance = frame % 3000 < 1500 ? 3000.0 - static_cast<double>(frame % 1500) * 2 : static_cast<double>(hash % 600);
+    ballAngle = static_cast<double>(hash % 90) - 45;
+  }
+};
+
+class NativeBehavior : public cabsl::Cabsl<NativeBehavior>, public Symbols
+{
+public:
+  NativeBehavior(cabsl::ActivationGraph* activationGraph = nullptr) :
+    Cabsl(activationGraph)
+  {
+  }
+
+#include "options.h"
+};
+
+/**
+ * Runs both implementations side by side and compares their results.
+ * @param program The bytecode program.
+ * @param frames The number of frames to run.
+ * @param filter The filter applied to both activation graphs.
+ * @return Did the results match in all frames and was the activation graph
+ *         recorded in at least one of them?
+ */
+static bool validate(const cabsl::BytecodeProgram& program, unsigned frames, const cabsl::ActivationSink::Filter& filter = {})
+{
+  cabsl::ActivationGraph nativeGraph;
+  cabsl::ActivationGraph interpretedGraph;
+  nativeGraph.setFilter(filter);
+  interpretedGraph.setFilter(filter);
+  NativeBehavior native(&nativeGraph);
+  Symbols symbols;
+  cabsl::BytecodeInterpreter interpreter;
+  interpreter.addInput("active", &symbols.active);
+  interpreter.addInput("ballDistance", &symbols.ballDistance);
+  interpreter.addInput("ballAngle", &symbols.ballAngle);
+  interpreter.addInput("ballSeen", &symbols.ballSeen);
+  interpreter.addInput("kicks", &symbols.kicks);
+  interpreter.addOutput("speed", &symbols.speed);
+  interpreter.addOutput("turn", &symbols.turn);
+  interpreter.addOutput("kick", &symbols.kick);
+  interpreter.addOutput("kicks", &symbols.kicks);
+  interpreter.setActivationGraph(&interpretedGraph);
+  if(!interpreter.load(program))
+  {
+    std::cerr << interpreter.getError() << "\n";
+    return false;
+  }
+
+  bool recorded = false;
+  for(unsigned frame = 0; frame < frames; ++frame)
+  {
+    native.update(frame);
+    symbols.update(frame);
+    native.beginFrame(frame * 10);
+    native.root();
+    native.endFrame();
+    interpreter.beginFrame(frame * 10);
+    interpreter.execute("root");
+    interpreter.endFrame();
+
+    bool same = native.speed == symbols.speed && native.turn == symbols.turn
+                && native.kick == symbols.kick && native.kicks == symbols.kicks
+                && nativeGraph.graph.size() == interpretedGraph.graph.size();
+    for(std::size_t i = 0; same && i < nativeGraph.graph.size(); ++i)
+    {
+      const cabsl::ActivationGraph::Node& a = nativeGraph.graph[i];
+      const cabsl::ActivationGraph::Node& b = interpretedGraph.graph[i];
+      same = a.option == b.option && a.depth == b.depth && a.state == b.state
+             && a.optionTime == b.optionTime && a.stateTime == b.stateTime;
+    }
+    if(!same)
+    {
+      std::cerr << "Mismatch in frame " << frame << "\n";
+      return false;
+    }
+    recorded |= !nativeGraph.graph.empty();
+  }
+  if(!recorded)
+    std::cerr << "The activation graph was never recorded\n";
+  return recorded;
+}
+
+/**
+ * Measures how long it takes to execute a behavior for a number of frames.
+ * @param behavior The behavior, which must provide `beginFrame`, `endFrame`, and `update`.
+ * @param execute A function that executes the root option.
+ * @param frames The number of frames.
+ * @return The average time per frame in ns.
+ */
+template<typename Behavior, typename Execute> static double measure(Behavior& behavior, Symbols& symbols,
+                                                                   Execute execute, unsigned frames)
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for(unsigned frame = 0; frame < frames; ++frame)
+  {
+    symbols.update(frame);
+    behavior.beginFrame(frame * 10);
+    execute();
+    behavior.endFrame();
+  }
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / frames;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned frames = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 1000000;
+
+  // The behavior is read from the file next to this one.
+  std::string filename = __FILE__;
+  filename = filename.substr(0, filename.find_last_of('/') + 1) + "options.h";
+  std::ifstream file(filename);
+  std::stringstream source;
+  source << file.rdbuf();
+  cabsl::BytecodeProgram program;
+  if(!file || !program.compile(source.str(), filename))
+  {
+    std::cerr << (file ? program.getError() : "cannot read " + filename) << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // Check that writing and reading the program preserves it.
+  std::stringstream stream;
+  cabsl::BytecodeProgram copy;
+  if(!program.write(stream) || !copy.read(stream) || copy.code != program.code)
+  {
+    std::cerr << "Program could not be written and read back\n";
+    return EXIT_FAILURE;
+  }
+
+  // Check that the verification recomputes the stack size of the compiler
+  // and rejects a program whose execution would run past its end.
+  cabsl::BytecodeProgram corrupted = program;
+  corrupted.maxStackSize = 0;
+  if(!corrupted.verify() || corrupted.maxStackSize != program.maxStackSize)
+  {
+    std::cerr << "Program was not verified correctly\n";
+    return EXIT_FAILURE;
+  }
+  corrupted.code.back() = cabsl::BytecodeProgram::commonTransition;
+  if(corrupted.verify())
+  {
+    std::cerr << "Corrupted program was not rejected\n";
+    return EXIT_FAILURE;
+  }
+
+  cabsl::ActivationSink::Filter depthAndInterval;
+  depthAndInterval.maxDepth = 2;
+  depthAndInterval.interval = 3;
+  cabsl::ActivationSink::Filter listsAndTrigger;
+  listsAndTrigger.deniedOptions = {"play_ball"};
+  listsAndTrigger.triggerOption = "kick_ball";
+  listsAndTrigger.triggerState = "kick";
+  listsAndTrigger.triggerFrames = 20;
+  cabsl::ActivationSink::Filter initialStateTrigger;
+  initialStateTrigger.triggerOption = "kick_ball";
+  initialStateTrigger.triggerState = "prepare";
+  cabsl::ActivationSink::Filter anyStateTrigger;
+  anyStateTrigger.triggerOption = "go_to_ball";
+  if(!validate(copy, 100000) || !validate(copy, 100000, depthAndInterval) || !validate(copy, 100000, listsAndTrigger)
+     || !validate(copy, 100000, initialStateTrigger) || !validate(copy, 100000, anyStateTrigger))
+    return EXIT_FAILURE;
+
+  NativeBehavior native;
+  Symbols symbols;
+  cabsl::BytecodeInterpreter interpreter;
+  interpreter.addInput("active", &symbols.active);
+  interpreter.addInput("ballDistance", &symbols.ballDistance);
+  interpreter.addInput("ballAngle", &symbols.ballAngle);
+  interpreter.addInput("ballSeen", &symbols.ballSeen);
+  interpreter.addInput("kicks", &symbols.kicks);
+  interpreter.addOutput("speed", &symbols.speed);
+  interpreter.addOutput("turn", &symbols.turn);
+  interpreter.addOutput("kick", &symbols.kick);
+  interpreter.addOutput("kicks", &symbols.kicks);
+  interpreter.load(program);
+  const std::int32_t root = interpreter.getOption("root");
+
+  const double nativeTime = measure(native, native, [&native] {native.root();}, frames);
+  const double interpretedTime = measure(interpreter, symbols, [&] {interpreter.execute(root);}, frames);
+  std::cout << "bytecode: " << program.code.size() << " instructions, "
+            << program.constants.size() << " constants, " << program.options.size() << " options\n"
+            << "native:      " << nativeTime << " ns/frame\n"
+            << "interpreted: " << interpretedTime << " ns/frame (" << interpretedTime / nativeTime << "x)\n";
+  return native.kicks == symbols.kicks ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file options.h
+ *
+ * A behavior that only uses the subset of CABSL supported by the bytecode
+ * compiler. It is both compiled natively and into bytecode by the benchmark.
+ */
+
+option(root)
+{
+  common_transition
+  {
+    if(!active)
+      goto idle;
+  }
+
+  initial_state(idle)
+  {
+    transition
+    {
+      if(active)
+        goto play;
+    }
+    action
+    {
+      speed = 0;
+      kick = false;
+    }
+  }
+
+  state(play)
+  {
+    transition
+    {
+      if(option_time > 5000 && ballDistance > 2000)
+        goto rest;
+    }
+    action
+    {
+      play_ball();
+    }
+  }
+
+  state(rest)
+  {
+    transition
+    {
+      if(state_time > 500)
+        goto play;
+    }
+    action
+    {
+      speed = 0.1 * ballDistance / 1000;
+      kick = false;
+    }
+  }
+}
+
+option(play_ball)
+{
+  initial_state(approach)
+  {
+    transition
+    {
+      if(action_done)
+        goto align;
+      else if(action_aborted)
+        goto search;
+    }
+    action
+    {
+      go_to_ball();
+    }
+  }
+
+  state(align)
+  {
+    transition
+    {
+      if(ballDistance > 400)
+        goto approach;
+      else if((-10 < ballAngle && ballAngle < 10) || state_time > 300)
+        goto shoot;
+    }
+    action
+    {
+      turn = -ballAngle / 45;
+      speed = 0;
+    }
+  }
+
+  state(shoot)
+  {
+    transition
+    {
+      if(action_done)
+        goto approach;
+    }
+    action
+    {
+      kick_ball();
+    }
+  }
+
+  state(search)
+  {
+    transition
+    {
+      if(ballSeen)
+        goto approach;
+    }
+    action
+    {
+      turn = 1;
+      speed = 0;
+    }
+  }
+}
+
+option(go_to_ball)
+{
+  common_transition
+  {
+    if(!ballSeen)
+      goto lost;
+  }
+
+  initial_state(walk)
+  {
+    transition
+    {
+      if(ballDistance < 300)
+        goto reached;
+    }
+    action
+    {
+      turn = ballAngle / 90;
+      if(ballDistance > 1000)
+        speed = 1;
+      else
+        speed = ballDistance / 1000;
+    }
+  }
+
+  target_state(reached)
+  {
+    transition
+    {
+      if(ballDistance >= 300)
+        goto walk;
+    }
+  }
+
+  aborted_state(lost)
+  {
+    transition
+    {
+      if(ballSeen)
+        goto walk;
+    }
+  }
+}
+
+option(kick_ball)
+{
+  initial_state(prepare)
+  {
+    transition
+    {
+      if(state_time >= 100)
+        goto kick;
+    }
+    action
+    {
+      speed = 0.2;
+    }
+  }
+
+  state(kick)
+  {
+    transition
+    {
+      if(state_time >= 50)
+        goto done;
+    }
+    action
+    {
+      kick = true;
+    }
+  }
+
+  target_state(done)
+  {
+    action
+    {
+      kick = false;
+      kicks = kicks + 1;
+    }
+  }
+}
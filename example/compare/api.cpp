@@ -0,0 +1,54 @@
+/**
+ * This file implements the interface through which the program compareBuilds
+ * replays logs with a build of the behavior of the CABSL Example Agents.
+ */
+
+#include <cstring>
+#include <sstream>
+#include "../behavior.h"
+#include "api.h"
+
+/** The behaviors of the four players of a team. */
+struct Team {
+  Behavior behaviors[4] = {Behavior(0), Behavior(1), Behavior(2), Behavior(3)};
+  Behavior::Action actions[4] = {Behavior::DO_NOTHING, Behavior::DO_NOTHING, Behavior::DO_NOTHING, Behavior::DO_NOTHING}; /**< The last actions of all players. */
+};
+
+void* create_team() {
+  return new Team;
+}
+
+void destroy_team(void* team) {
+  delete static_cast<Team*>(team);
+}
+
+std::size_t frame_size() {
+  return sizeof(Frame);
+}
+
+int replay_frame(void* team, const Frame* frame, std::uint64_t* activation_graph) {
+  Team& t = *static_cast<Team*>(team);
+  Behavior& behavior = t.behaviors[frame->player_number];
+  t.actions[frame->player_number] = behavior.replay(*frame);
+  *activation_graph = behavior.get_activation_graph().hash();
+  return t.actions[frame->player_number];
+}
+
+std::size_t describe_step(const void* team, int player_number, char* buffer, std::size_t size) {
+  const Team& t = *static_cast<const Team*>(team);
+  std::ostringstream stream;
+  stream << "action = " << t.actions[player_number] << "\n";
+  for (const cabsl::ActivationGraph::Node& node : t.behaviors[player_number].get_activation_graph().graph) {
+    stream << std::string((node.depth - 1) * 2, ' ') << node.option;
+    for (const std::string& argument : node.arguments)
+      stream << " " << argument;
+    stream << " [" << node.state << "] " << node.optionTime << "/" << node.stateTime << "\n";
+  }
+  const std::string text = stream.str();
+  if (size) {
+    const std::size_t length = text.size() < size ? text.size() : size - 1;
+    std::memcpy(buffer, text.data(), length);
+    buffer[length] = 0;
+  }
+  return text.size();
+}
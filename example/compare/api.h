@@ -0,0 +1,56 @@
+/**
+ * This file declares the interface through which the program compareBuilds
+ * replays logs with a build of the behavior of the CABSL Example Agents that
+ * was compiled into a shared library. All functions have C linkage, so they
+ * can be looked up by name. Everything else in the library is hidden, so that
+ * two builds of the same behavior can be loaded into the same process.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../frame.h"
+
+#define BEHAVIOR_API extern "C" __attribute__((visibility("default")))
+
+/**
+ * Create the behaviors of a team in their initial states.
+ * @return The team.
+ */
+BEHAVIOR_API void* create_team();
+
+/**
+ * Destroy a team.
+ * @param team The team.
+ */
+BEHAVIOR_API void destroy_team(void* team);
+
+/**
+ * Return the size of the frames this build replays. Logs with other frame
+ * sizes cannot be replayed.
+ * @return The size of a frame in bytes.
+ */
+BEHAVIOR_API std::size_t frame_size();
+
+/**
+ * Execute a recorded behavior step with the behavior of the player it was
+ * recorded for. The state shared by the team is set as it was recorded.
+ * @param team The team.
+ * @param frame The step recorded.
+ * @param activation_graph The hash of the activation graph is returned here.
+ * @return The next action to perform.
+ */
+BEHAVIOR_API int replay_frame(void* team, const Frame* frame, std::uint64_t* activation_graph);
+
+/**
+ * Describe the last step of a player as text, i.e. the action it returned
+ * and its activation graph.
+ * @param team The team.
+ * @param player_number The number of the player [0..3].
+ * @param buffer The text is written to this buffer. It is always terminated
+ *               and truncated if necessary.
+ * @param size The size of the buffer in bytes.
+ * @return The length of the whole text.
+ */
+BEHAVIOR_API std::size_t describe_step(const void* team, int player_number, char* buffer, std::size_t size);
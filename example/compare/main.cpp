@@ -0,0 +1,158 @@
+/**
+ * This program compares two builds of the behavior of the CABSL Example
+ * Agents by replaying recorded games with both of them (see replay.cpp).
+ * Each build is a shared library that implements the interface declared
+ * in api.h. Both builds are fed the same recorded inputs and the program
+ * reports the first frame of each log in which their actions or activation
+ * graphs differ. The logs are distributed over as many threads as there
+ * are cores. Each log is replayed by a single thread, because each frame
+ * depends on the previous ones.
+ *
+ * Usage: compareBuilds <build1.so> <build2.so> <log> ...
+ */
+
+#include <dlfcn.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Recorder.h>
+#include "api.h"
+
+/** A build of the behavior loaded from a shared library. */
+struct Build {
+  std::string path; /**< The path to the shared library. */
+  void* handle = nullptr; /**< The handle of the shared library. */
+  decltype(&create_team) create = nullptr; /**< The function create_team of the build. */
+  decltype(&destroy_team) destroy = nullptr; /**< The function destroy_team of the build. */
+  decltype(&frame_size) get_frame_size = nullptr; /**< The function frame_size of the build. */
+  decltype(&replay_frame) replay = nullptr; /**< The function replay_frame of the build. */
+  decltype(&describe_step) describe_last_step = nullptr; /**< The function describe_step of the build. */
+
+  /**
+   * Load a build.
+   * @param path The path to the shared library.
+   * @return Was it loaded successfully?
+   */
+  bool load(const std::string& path) {
+    this->path = path;
+    const std::string file = path.find('/') == std::string::npos ? "./" + path : path; // Do not search the library path
+    handle = dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+      std::cerr << dlerror() << "\n";
+      return false;
+    }
+    create = reinterpret_cast<decltype(create)>(dlsym(handle, "create_team"));
+    destroy = reinterpret_cast<decltype(destroy)>(dlsym(handle, "destroy_team"));
+    get_frame_size = reinterpret_cast<decltype(get_frame_size)>(dlsym(handle, "frame_size"));
+    replay = reinterpret_cast<decltype(replay)>(dlsym(handle, "replay_frame"));
+    describe_last_step = reinterpret_cast<decltype(describe_last_step)>(dlsym(handle, "describe_step"));
+    if (!create || !destroy || !get_frame_size || !replay || !describe_last_step) {
+      std::cerr << path << " is not a behavior build\n";
+      return false;
+    }
+    if (get_frame_size() != sizeof(Frame)) {
+      std::cerr << path << " replays frames of " << get_frame_size() << " instead of " << sizeof(Frame) << " bytes\n";
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Return the last step of a player as text.
+   * @param team The team of this build.
+   * @param player_number The number of the player [0..3].
+   * @return The action and the activation graph of the step.
+   */
+  std::string describe(const void* team, int player_number) const {
+    std::string text(describe_last_step(team, player_number, nullptr, 0) + 1, 0);
+    describe_last_step(team, player_number, text.data(), text.size());
+    text.pop_back();
+    return text;
+  }
+};
+
+/** The result of comparing both builds on a single log. */
+struct Result {
+  size_t frames = 0; /**< The number of frames replayed. */
+  std::string report; /**< A description of the first difference or of an error. Empty if there was none. */
+};
+
+/**
+ * Replay a single log with both builds until they differ.
+ * @param builds The two builds.
+ * @param path The path to the log.
+ * @return The result of the comparison.
+ */
+static Result compare(const Build (&builds)[2], const std::string& path) {
+  Result result;
+  const cabsl::Recording<Frame> recording(path);
+  if (!recording.getError().empty()) {
+    result.report = recording.getError() + "\n";
+    return result;
+  }
+
+  void* teams[2] = {builds[0].create(), builds[1].create()};
+  for (const Frame& frame : recording.getRecords()) {
+    if (frame.player_number < 0 || frame.player_number > 3) {
+      result.report = path + ": frame " + std::to_string(result.frames) + " is invalid\n";
+      break;
+    }
+    std::uint64_t activation_graphs[2];
+    const int actions[2] = {builds[0].replay(teams[0], &frame, &activation_graphs[0]),
+                            builds[1].replay(teams[1], &frame, &activation_graphs[1])};
+    if (actions[0] != actions[1] || activation_graphs[0] != activation_graphs[1]) {
+      result.report = path + ": frame " + std::to_string(result.frames) + " of player "
+                      + std::to_string(frame.player_number + 1) + " differs\n";
+      for (int i = 0; i < 2; ++i)
+        result.report += builds[i].path + ":\n" + builds[i].describe(teams[i], frame.player_number);
+      break;
+    }
+    ++result.frames;
+  }
+  builds[0].destroy(teams[0]);
+  builds[1].destroy(teams[1]);
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    std::cerr << "usage: compareBuilds <build1.so> <build2.so> <log> ...\n";
+    return 2;
+  }
+
+  Build builds[2];
+  if (!builds[0].load(argv[1]) || !builds[1].load(argv[2]))
+    return 2;
+
+  // Distribute the logs over all cores. Each thread fetches the next log not replayed yet.
+  const std::vector<std::string> logs(argv + 3, argv + argc);
+  std::vector<Result> results(logs.size());
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> threads(std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(logs.size()))));
+  const auto start = std::chrono::steady_clock::now();
+  for (std::thread& thread : threads)
+    thread = std::thread([&] {
+      for (size_t i = next++; i < logs.size(); i = next++)
+        results[i] = compare(builds, logs[i]);
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  size_t frames = 0, differences = 0;
+  for (const Result& result : results) {
+    frames += result.frames;
+    if (!result.report.empty()) {
+      ++differences;
+      std::cout << result.report << "\n";
+    }
+  }
+  std::cout << logs.size() - differences << " of " << logs.size() << " logs identical, "
+            << frames << " frames compared in " << seconds << " s with " << threads.size() << " threads ("
+            << static_cast<long>(seconds > 0 ? static_cast<double>(frames) / seconds : 0) << " frames/s)\n";
+  return differences ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+/**
+ * This file declares the record of a behavior step of the CABSL Example
+ * Agents that is written to logs and replayed. It is kept separate from
+ * the behavior, so that programs can read logs without containing the
+ * behavior.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * A behavior step as it is recorded: its inputs, the state shared by the
+ * team before the step, and its results. All values fit into bytes.
+ */
+struct Frame {
+  std::uint64_t activation_graph; /**< The hash of the activation graph after the step. */
+  std::int8_t player_number; /**< The number of the player [0..3]. */
+  std::int8_t local_area[9]; /**< The local area as passed by ascii soccer. */
+  std::int8_t ball_direction; /**< The ball direction as passed by ascii soccer. */
+  std::int8_t x; /**< The player's x coordinate as passed by ascii soccer. */
+  std::int8_t y; /**< The player's y coordinate as passed by ascii soccer. */
+  std::int8_t team_ball_direction[4]; /**< The shared ball directions of all players. */
+  std::int8_t team_x[4]; /**< The shared x coordinates of all players. */
+  std::int8_t team_y[4]; /**< The shared y coordinates of all players. */
+  std::int8_t ball_x; /**< The shared estimate of the ball's x coordinate. */
+  std::int8_t ball_y; /**< The shared estimate of the ball's y coordinate. */
+  std::int8_t next_action; /**< The action returned. */
+};
@@ -0,0 +1,49 @@
+/**
+ * This program writes the graphs of the behavior of the CABSL Example
+ * Agents in GraphViz's dot format, using the structure registered by the
+ * compiled behavior (see BehaviorGraph.h) instead of parsing the sources.
+ * The state transitions and option calls are collected by replaying
+ * recorded games (see main.cpp), i.e. only those that were executed in
+ * these games are contained in the graphs. The graphs created by
+ * `bin/createGraphs` also contain the ones that were never executed.
+ * All files of this program must be compiled with `CABSL_INSTRUMENTATION`
+ * defined, because the edge statistics are part of the instrumentation.
+ *
+ * Usage: exportGraphs <directory> <log> ...
+ */
+
+#include <iostream>
+#include <BehaviorGraph.h>
+#include "behavior.h"
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "usage: exportGraphs <directory> <log> ...\n";
+    return 2;
+  }
+
+  cabsl::EdgeStatistics edge_statistics;
+  Behavior behaviors[4] = {Behavior(0), Behavior(1), Behavior(2), Behavior(3)};
+  for (Behavior& behavior : behaviors)
+    behavior.setEdgeStatistics(&edge_statistics);
+
+  for (int i = 2; i < argc; ++i) {
+    const cabsl::Recording<Frame> recording(argv[i]);
+    if (!recording.getError().empty()) {
+      std::cerr << recording.getError() << "\n";
+      return 1;
+    }
+    for (const Frame& frame : recording.getRecords())
+      if (frame.player_number >= 0 && frame.player_number <= 3)
+        behaviors[frame.player_number].replay(frame);
+  }
+
+  cabsl::BehaviorGraph behavior_graph;
+  Behavior::OptionInfos::describe(behavior_graph);
+  behavior_graph.addStatistics(edge_statistics);
+  if (!behavior_graph.write(argv[1], "options")) {
+    std::cerr << "cannot write graphs to " << argv[1] << "\n";
+    return 1;
+  }
+  return 0;
+}
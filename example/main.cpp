@@ -9,6 +9,8 @@
 extern "C" {
 #include <players.h>
 }
+#include <cstdlib>
+#include <memory>
 #include "behavior.h"
 
 /*
@@ -40,6 +42,9 @@ move (N, NE, E, S, etc) or KICK to kick the ball.
 
 static Behavior behaviors[4] = {Behavior(0), Behavior(1), Behavior(2), Behavior(3)};
 
+/* If the environment variable CABSL_RECORD is set, the game is recorded to the log file it names. */
+static std::unique_ptr<cabsl::Recorder<Frame>> recorder;
+
 /*-----------------------------------------------------
 
 	player1()
@@ -109,6 +114,10 @@ char *UN(team_name)()
 -----------------------------------------------------*/
 void UN(initialize_game)()
 {
+  if (const char* path = std::getenv("CABSL_RECORD")) {
+    recorder = std::make_unique<cabsl::Recorder<Frame>>(path);
+    Behavior::recorder = recorder.get();
+  }
 }
 
 /*-----------------------------------------------------
@@ -164,4 +173,6 @@ void UN(won_point)()
 -----------------------------------------------------*/
 void UN(game_over)()
 {
+  Behavior::recorder = nullptr;
+  recorder.reset();
 }
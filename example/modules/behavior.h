@@ -0,0 +1,26 @@
+/**
+ * This file declares a small behavior whose options are implemented in a
+ * separate file. That file is both linked into the program and compiled
+ * into a module that can replace the options while the program is running.
+ */
+
+#pragma once
+
+#include <Cabsl.h>
+
+class Behavior : public cabsl::Cabsl<Behavior>
+{
+public:
+  /**
+   * Constructor.
+   * @param activationSink The sink the options and states of each frame are reported to.
+   */
+  Behavior(cabsl::ActivationSink* activationSink) :
+    Cabsl(activationSink)
+  {}
+
+  int ticks = 0; /**< Output: Is increased by the behavior. */
+
+  option(root);
+  option(count, args((int) limit));
+};
@@ -0,0 +1,95 @@
+/**
+ * This program executes a behavior and replaces its options by the ones
+ * in a module whenever the file of the module changes. It prints the
+ * nodes of the activation graph that were added, removed, or changed
+ * whenever the graph changes. The differences are determined by an
+ * indexed activation graph, i.e. the graph is not compared as a whole.
+ *
+ * Usage: moduleHost <module> [<frames>]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <string>
+#include <IndexedActivationGraph.h>
+#include <ModuleLoader.h>
+#include "behavior.h"
+
+/**
+ * Prints a node of the activation graph.
+ * @param graph The graph that contains the node.
+ * @param index The index of the node.
+ * @param mark The character that states what happened to the node.
+ */
+static void printNode(const cabsl::IndexedActivationGraph& graph, int index, char mark)
+{
+  std::cout << mark << std::string(graph.depths[index] * 2, ' ') << graph.getOptionName(index);
+  if(!graph.getStateName(index).empty())
+    std::cout << ": " << graph.getStateName(index);
+  if(graph.active[index])
+    for(std::size_t i = 0; i < graph.argumentCounts[index]; ++i)
+      std::cout << (i ? ", " : " (") << graph.arguments[graph.argumentOffsets[index] + i] << (i + 1 == graph.argumentCounts[index] ? ")" : "");
+  std::cout << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+  if(argc < 2)
+  {
+    std::cerr << "usage: " << argv[0] << " <module> [<frames>]\n";
+    return EXIT_FAILURE;
+  }
+  const std::filesystem::path module = std::filesystem::absolute(argv[1]);
+  const unsigned frames = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : static_cast<unsigned>(-1);
+
+  cabsl::IndexedActivationGraph graph;
+  Behavior behavior(&graph);
+  cabsl::ModuleLoader<Behavior> loader({&behavior});
+  std::filesystem::file_time_type lastWriteTime;
+
+  for(unsigned frame = 0; frame < frames; ++frame)
+  {
+    // Reload the module if it changed. The loader is updated between frames.
+    std::error_code error;
+    const std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(module, error);
+    if(!error && writeTime != lastWriteTime)
+    {
+      lastWriteTime = writeTime;
+      loader.load(module.string());
+    }
+    if(!loader.update())
+      std::cerr << loader.getError() << "\n";
+
+    behavior.beginFrame(frame * 100);
+    behavior.execute("root");
+    behavior.endFrame();
+
+    // Print the nodes added or changed in the order of the graph, then the ones removed.
+    bool headerPrinted = false;
+    const auto printHeader = [&]
+    {
+      if(!headerPrinted)
+        std::cout << "frame " << frame << ", ticks " << behavior.ticks << "\n";
+      headerPrinted = true;
+    };
+    for(int index : graph.order)
+      if(graph.added[index] || graph.changed[index])
+      {
+        printHeader();
+        printNode(graph, index, graph.added[index] ? '+' : '*');
+      }
+    for(std::size_t index = 0; index < graph.size(); ++index)
+      if(graph.removed[index])
+      {
+        printHeader();
+        printNode(graph, static_cast<int>(index), '-');
+      }
+    std::cout << std::flush;
+    if(frames == static_cast<unsigned>(-1))
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  return EXIT_SUCCESS;
+}
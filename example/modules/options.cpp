@@ -0,0 +1,50 @@
+/**
+ * This file implements the options of the behavior. Change it and run
+ * `make module.so` while `moduleHost` is running to replace them.
+ */
+
+#include "behavior.h"
+
+option((Behavior) root)
+{
+  initial_state(wait)
+  {
+    transition
+    {
+      if(state_time >= 500)
+        goto work;
+    }
+  }
+
+  state(work)
+  {
+    transition
+    {
+      if(action_done)
+        goto wait;
+    }
+    action
+    {
+      count({.limit = 10});
+    }
+  }
+}
+
+option((Behavior) count, args((int) limit), vars((int)(0) counter))
+{
+  initial_state(counting)
+  {
+    transition
+    {
+      if(counter >= limit)
+        goto done;
+    }
+    action
+    {
+      ++counter;
+      ++ticks;
+    }
+  }
+
+  target_state(done) {}
+}
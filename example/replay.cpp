@@ -0,0 +1,68 @@
+/**
+ * This program replays games recorded by the CABSL Example Agents (see
+ * main.cpp). It feeds the recorded inputs back into the behavior as fast
+ * as possible and checks that it still returns the same actions and
+ * produces the same activation graphs. This allows to verify that a
+ * change of the behavior did not change its decisions and to measure how
+ * fast the behavior is executed.
+ *
+ * Usage: replay <log> ...
+ */
+
+#include <chrono>
+#include <iostream>
+#include "behavior.h"
+
+/**
+ * Replays a single log.
+ * @param path The path to the log.
+ * @return Was the log replayed without differences?
+ */
+static bool replay(const char* path) {
+  const cabsl::Recording<Frame> recording(path);
+  if (!recording.getError().empty()) {
+    std::cerr << recording.getError() << "\n";
+    return false;
+  }
+
+  Behavior behaviors[4] = {Behavior(0), Behavior(1), Behavior(2), Behavior(3)};
+  const std::vector<Frame>& frames = recording.getRecords();
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < frames.size(); ++i) {
+    const Frame& frame = frames[i];
+    if (frame.player_number < 0 || frame.player_number > 3) {
+      std::cerr << path << ": frame " << i << " is invalid\n";
+      return false;
+    }
+    Behavior& behavior = behaviors[frame.player_number];
+    if (behavior.replay(frame) != frame.next_action
+        || behavior.get_activation_graph().hash() != frame.activation_graph) {
+      std::cout << path << ": frame " << i << " of player " << frame.player_number + 1
+                << " differs, recorded action " << static_cast<Behavior::Action>(frame.next_action)
+                << ", activation graph now:\n";
+      for (const cabsl::ActivationGraph::Node& node : behavior.get_activation_graph().graph) {
+        std::cout << std::string((node.depth - 1) * 2, ' ') << node.option;
+        for (const std::string& argument : node.arguments)
+          std::cout << " " << argument;
+        std::cout << " [" << node.state << "]\n";
+      }
+      return false;
+    }
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << path << ": " << frames.size() << " frames identical, "
+            << static_cast<long>(seconds > 0 ? static_cast<double>(frames.size()) / seconds : 0) << " frames/s\n";
+  return true;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    std::cerr << "usage: replay <log> ...\n";
+    return 2;
+  }
+
+  bool success = true;
+  for (int i = 1; i < argc; ++i)
+    success &= replay(argv[i]);
+  return success ? 0 : 1;
+}
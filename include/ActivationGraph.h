@@ -6,17 +6,30 @@
  * theoretically makes the tree an acyclic graph. However, the representation
  * is still the one of a tree.
  *
+ * The graph is filled as a sink of the behavior (see ActivationSink.h). A
+ * filter can restrict which options are recorded and in which frames. Options
+ * that are not recorded do not even convert their arguments to text. Example:
+ *
+ *     cabsl::ActivationGraph::Filter filter;
+ *     filter.maxDepth = 3;
+ *     filter.deniedOptions = {"set_action"};
+ *     filter.interval = 10;
+ *     activationGraph.setFilter(filter);
+ *
  * @author Thomas Röfer
  */
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
+#include "ActivationSink.h"
 
 namespace cabsl
 {
-  struct ActivationGraph
+  struct ActivationGraph : public ActivationSink
   {
     /** A node of the graph. */
     struct Node
@@ -35,13 +48,13 @@ namespace cabsl
        */
       Node(const std::string& option, int depth,
            const std::string& state, int optionTime,
-           int stateTime, const std::vector<std::string>& arguments) :
+           int stateTime, std::vector<std::string> arguments) :
       option(option),
       depth(depth),
       state(state),
       optionTime(optionTime),
       stateTime(stateTime),
-      arguments(arguments)
+      arguments(std::move(arguments))
       {
       }
 
@@ -59,6 +72,83 @@ namespace cabsl
       graph.reserve(100);
     }
 
+    /**
+     * Computes a hash of all nodes of the graph (FNV-1a). Graphs with the same
+     * contents have the same hash, so it can be stored instead of the graph to
+     * compare it later.
+     * @return The hash.
+     */
+    std::uint64_t hash() const
+    {
+      std::uint64_t hash = 14695981039346656037ull;
+      const auto addNumber = [&hash](int number)
+      {
+        for(int i = 0; i < 4; ++i)
+          hash = (hash ^ (static_cast<unsigned>(number) >> (8 * i) & 0xff)) * 1099511628211ull;
+      };
+      const auto addText = [&hash, &addNumber](const std::string& text)
+      {
+        addNumber(static_cast<int>(text.size()));
+        for(const char c : text)
+          hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+      };
+      for(const Node& node : graph)
+      {
+        addText(node.option);
+        addText(node.state);
+        addNumber(node.depth);
+        addNumber(node.optionTime);
+        addNumber(node.stateTime);
+        addNumber(static_cast<int>(node.arguments.size()));
+        for(const std::string& argument : node.arguments)
+          addText(argument);
+      }
+      return hash;
+    }
+
+    /** The graph is cleared at the beginning of each frame. */
+    void beginFrame(unsigned, bool) override
+    {
+      graph.clear();
+    }
+
+    /**
+     * Adds a node for an option.
+     * @param option The name of the option.
+     * @param depth The level in the call hierarchy.
+     * @param optionTime How long is the option already active?
+     */
+    void enterOption(const char* option, int depth, int optionTime) override
+    {
+      Node& node = graph.emplace_back();
+      node.option = option;
+      node.depth = depth;
+      node.optionTime = optionTime;
+    }
+
+    /**
+     * Sets the state of the node added last.
+     * @param state The name of the state.
+     * @param stateTime How long is the state already active?
+     */
+    void enterState(const char* state, int stateTime) override
+    {
+      graph.back().state = state;
+      graph.back().stateTime = stateTime;
+    }
+
+    /**
+     * Adds an argument to the node added last.
+     * @param name The name of the argument.
+     * @param value The value of the argument as text.
+     */
+    void addArgument(const char* name, const std::string& value) override
+    {
+      std::string& argument = graph.back().arguments.emplace_back(name);
+      argument += " = ";
+      argument += value;
+    }
+
     std::vector<Node> graph; /**< The nodes of the graph. */
   };
 }
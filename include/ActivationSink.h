@@ -0,0 +1,174 @@
+/**
+ * @file ActivationSink.h
+ *
+ * The interface through which a behavior reports the options and states it
+ * executes. For each option that is recorded, the behavior calls
+ * `enterOption`, then `enterState`, and then `addArgument` for each of its
+ * arguments and variables, in the order of the activation graph. Therefore,
+ * a sink can directly process the events, e.g. write them to a log or send
+ * them over the network, without building a graph first. `ActivationGraph`
+ * is the sink that collects them in a vector of nodes.
+ *
+ * Example:
+ *
+ *     class Printer : public cabsl::ActivationSink
+ *     {
+ *       void enterOption(const char* option, int depth, int) override {std::cout << std::string(depth * 2, ' ') << option;}
+ *       void enterState(const char* state, int) override {std::cout << ": " << state << "\n";}
+ *     };
+ *
+ *     Printer printer;
+ *     Behavior behavior(&printer);
+ *
+ * A filter can restrict which options are recorded and in which frames. Options
+ * that are not recorded do not even convert their arguments to text.
+ *
+ * An option is reported after its transitions were executed, i.e. options it
+ * called from its transitions through `select_option` are reported before
+ * it. Sinks that need the actual call hierarchy can request to be notified
+ * through `beginCall` and `endCall` whenever any option is entered and left.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace cabsl
+{
+  class ActivationSink
+  {
+  public:
+    /** Restricts which options are recorded and in which frames. */
+    struct Filter
+    {
+      int maxDepth = 0; /**< Options called deeper than this are not recorded. 0 records all depths. */
+      std::vector<std::string> allowedOptions; /**< If not empty, only these options are recorded. */
+      std::vector<std::string> deniedOptions; /**< These options are not recorded. */
+      unsigned interval = 1; /**< Only every n-th frame is recorded. */
+      std::string triggerOption; /**< If set, frames are only recorded after this option entered the trigger state, including its initial state when it is activated. */
+      std::string triggerState; /**< The state that triggers recording. Any state if empty. */
+      unsigned triggerFrames = 1; /**< After the trigger fired, the rest of that frame and this number of frames are recorded. */
+
+      /**
+       * Is an option recorded at all?
+       * @param option The name of the option.
+       * @return Is it allowed and not denied?
+       */
+      bool accepts(const std::string& option) const
+      {
+        return (allowedOptions.empty() || contains(allowedOptions, option)) && !contains(deniedOptions, option);
+      }
+
+      /**
+       * Is an option contained in a list?
+       * @param options The list of option names.
+       * @param option The name of the option.
+       * @return Is it contained?
+       */
+      static bool contains(const std::vector<std::string>& options, const std::string& option)
+      {
+        for(const std::string& entry : options)
+          if(entry == option)
+            return true;
+        return false;
+      }
+
+      /**
+       * Does entering a state fire the trigger?
+       * @param option The name of the option that entered the state.
+       * @param state The name of the state.
+       * @return Is it the trigger state of the trigger option?
+       */
+      bool triggers(const char* option, const char* state) const
+      {
+        return option == triggerOption && (triggerState.empty() || state == triggerState);
+      }
+    };
+
+  protected:
+    bool callsReported = false; /**< Are `beginCall` and `endCall` called? Set by sinks that need them. */
+
+  public:
+    virtual ~ActivationSink() = default;
+
+    /**
+     * Is called at the beginning of each frame, whether it is recorded or not.
+     * @param frameTime The time of the frame in ms.
+     * @param recorded Is the frame recorded from its beginning? If not, options
+     *                 are only reported if the trigger of the filter fires.
+     */
+    virtual void beginFrame(unsigned frameTime, bool recorded) {static_cast<void>(frameTime); static_cast<void>(recorded);}
+
+    /** Is called at the end of each frame, whether it is recorded or not. */
+    virtual void endFrame() {}
+
+    /**
+     * Is called when an option is recorded.
+     * @param option The name of the option.
+     * @param depth The level in the call hierarchy.
+     * @param optionTime How long is the option already active?
+     */
+    virtual void enterOption(const char* option, int depth, int optionTime) = 0;
+
+    /**
+     * Is called after `enterOption` with the state the option is in.
+     * @param state The name of the state. Empty if it is not known.
+     * @param stateTime How long is the state already active?
+     */
+    virtual void enterState(const char* state, int stateTime) = 0;
+
+    /**
+     * Is called after `enterState` for each argument and variable of the option
+     * that can be streamed. Arguments that have their default values are skipped.
+     * @param name The name of the argument or variable.
+     * @param value The value as text. Only valid during the call.
+     */
+    virtual void addArgument(const char* name, const std::string& value) {static_cast<void>(name); static_cast<void>(value);}
+
+    /**
+     * Is called whenever an option is entered, whether it is recorded or not,
+     * if `reportsCalls` returns true. An option is always reported between
+     * the calls of `beginCall` and `endCall` that bracket its execution, when
+     * the options it called have already been left.
+     * @param option The name of the option.
+     */
+    virtual void beginCall(const char* option) {static_cast<void>(option);}
+
+    /** Is called whenever an option is left if `reportsCalls` returns true. */
+    virtual void endCall() {}
+
+    /**
+     * Does this sink want to be notified about all calls of options?
+     * @return Are `beginCall` and `endCall` called?
+     */
+    bool reportsCalls() const {return callsReported;}
+
+    /**
+     * Sets the filter. It is applied from the next option call on.
+     * @param filter The new filter.
+     */
+    void setFilter(const Filter& filter)
+    {
+      this->filter = filter;
+      ++filterVersion;
+    }
+
+    /**
+     * Returns the filter.
+     * @return The filter currently used.
+     */
+    const Filter& getFilter() const {return filter;}
+
+    /**
+     * Returns the number of times the filter was set. Options cache whether the
+     * filter accepts them until it changes.
+     * @return The version of the filter.
+     */
+    unsigned getFilterVersion() const {return filterVersion;}
+
+  private:
+    Filter filter; /**< The filter applied when options are recorded. */
+    unsigned filterVersion = 1; /**< Incremented whenever the filter changes. */
+  };
+}
@@ -0,0 +1,336 @@
+/**
+ * @file AllocationTracker.h
+ *
+ * Tracks heap allocations that happen while a behavior frame runs, i.e.
+ * between `beginFrame` and `endFrame`, and attributes them to the option
+ * and state that were executed when the allocation happened. This includes
+ * allocations caused by CABSL itself, e.g. when variables are created or
+ * arguments are added to the activation graph, as well as allocations in
+ * user code inside options. Allocations outside of options are attributed
+ * to the frame itself. Allocations of other instrumentation, e.g. of the
+ * tracer or the profiler, are not counted.
+ *
+ * The tracker can also be used to ensure that a behavior does not allocate
+ * any memory anymore after a warm-up period. If this is requested through
+ * `failAfter`, the first allocation in a later frame is reported and the
+ * program is aborted.
+ *
+ * To count allocations, the global operators `new` and `delete` must be
+ * replaced. This is done by defining `CABSL_TRACK_ALLOCATIONS` in exactly
+ * one compilation unit of the program before this file or `Cabsl.h` is
+ * included:
+ *
+ *     #define CABSL_TRACK_ALLOCATIONS
+ *     #include "Cabsl.h"
+ *
+ * Then, the tracker can be set for a behavior:
+ *
+ *     cabsl::AllocationTracker allocationTracker;
+ *     allocationTracker.failAfter(100); // optional
+ *     behavior.setAllocationTracker(&allocationTracker);
+ *     ...
+ *     allocationTracker.writeReport(std::cout);
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <map>
+#include <new>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cabsl
+{
+  class AllocationTracker
+  {
+    /** The statistics collected for an option/state pair. */
+    struct Entry
+    {
+      std::size_t count = 0; /**< The number of allocations. */
+      std::size_t bytes = 0; /**< The number of bytes allocated. */
+    };
+
+    /** An option currently executed. */
+    struct Call
+    {
+      const char* option; /**< The name of the option. */
+      const char* const* state; /**< The address of the name of the option's current state. */
+    };
+
+    static constexpr int maxDepth = 64; /**< The maximum depth of calls tracked. Deeper calls are attributed to their ancestor. */
+
+    Call calls[maxDepth]; /**< The options currently executed. */
+    int depth = 0; /**< The number of options currently executed. */
+    std::map<std::pair<const char*, const char*>, Entry> entries; /**< The statistics, indexed by the addresses of option and state names. */
+    std::size_t frees = 0; /**< The number of deallocations during frames. */
+    unsigned frames = 0; /**< The number of frames tracked. */
+    unsigned warmUpFrames = 0; /**< The number of frames after which allocations fail. */
+    bool failing = false; /**< Do allocations fail after the warm-up period? */
+
+    /**
+     * The tracker of the frame currently executed in this thread.
+     * Is null outside of frames and while the tracker itself allocates memory.
+     */
+    static AllocationTracker*& active()
+    {
+      static thread_local AllocationTracker* tracker = nullptr;
+      return tracker;
+    }
+
+  public:
+    /**
+     * Suspends tracking allocations in this thread while it exists, e.g. while
+     * other instrumentation allocates memory during a frame.
+     */
+    class Suspension
+    {
+      AllocationTracker* tracker; /**< The tracker that is resumed. Null if none is suspended. */
+
+    public:
+      /**
+       * Constructor.
+       * @param tracker The tracker that is suspended if it is active. Nothing is done if it is null.
+       */
+      Suspension(const AllocationTracker* tracker) :
+        tracker(tracker ? active() : nullptr)
+      {
+        if(this->tracker)
+          active() = nullptr;
+      }
+
+      /** The destructor resumes the tracker. */
+      ~Suspension()
+      {
+        if(tracker)
+          active() = tracker;
+      }
+
+      Suspension(const Suspension&) = delete;
+      Suspension& operator=(const Suspension&) = delete;
+    };
+
+    AllocationTracker() = default;
+    AllocationTracker(const AllocationTracker&) = delete;
+    AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+    /**
+     * Lets all allocations fail after a number of frames, i.e. the program will
+     * be aborted with a message stating the option and state responsible.
+     * @param warmUpFrames The number of frames in which allocations are still permitted.
+     */
+    void failAfter(unsigned warmUpFrames)
+    {
+      this->warmUpFrames = warmUpFrames;
+      failing = true;
+    }
+
+    /** Called at the beginning of each frame. Starts tracking allocations in this thread. */
+    void beginFrame()
+    {
+      depth = 0;
+      active() = this;
+    }
+
+    /** Called at the end of each frame. Stops tracking allocations. */
+    void endFrame()
+    {
+      active() = nullptr;
+      ++frames;
+    }
+
+    /**
+     * Records that an option begins.
+     * @param option The name of the option.
+     * @param state The address of the name of the option's current state.
+     */
+    void enter(const char* option, const char* const* state)
+    {
+      if(depth < maxDepth)
+        calls[depth] = {option, state};
+      ++depth;
+    }
+
+    /** Records that the option entered last ends. */
+    void exit()
+    {
+      --depth;
+    }
+
+    /**
+     * Records an allocation if a frame is currently tracked in this thread.
+     * Called by the replacement of the operator `new`.
+     * @param size The number of bytes allocated.
+     */
+    static void allocated(std::size_t size)
+    {
+      AllocationTracker* tracker = active();
+      if(tracker)
+      {
+        active() = nullptr; // Do not track allocations of the tracker itself
+        const Call* call = tracker->depth ? &tracker->calls[std::min(tracker->depth, maxDepth) - 1] : nullptr;
+        const char* option = call ? call->option : nullptr;
+        const char* state = call ? *call->state : nullptr;
+        if(tracker->failing && tracker->frames >= tracker->warmUpFrames)
+        {
+          std::fprintf(stderr, "cabsl::AllocationTracker: %zu bytes allocated in frame %u in option '%s', state '%s'\n",
+                       size, tracker->frames, option ? option : "", state ? state : "");
+          std::abort();
+        }
+        Entry& entry = tracker->entries[{option, state}];
+        ++entry.count;
+        entry.bytes += size;
+        active() = tracker;
+      }
+    }
+
+    /** Records a deallocation. Called by the replacement of the operator `delete`. */
+    static void freed()
+    {
+      if(AllocationTracker* tracker = active(); tracker)
+        ++tracker->frees;
+    }
+
+    /** Discards all statistics collected so far. */
+    void reset()
+    {
+      entries.clear();
+      frees = 0;
+      frames = 0;
+    }
+
+    /**
+     * Returns the number of allocations tracked so far.
+     * @return The number of allocations.
+     */
+    std::size_t getAllocations() const
+    {
+      std::size_t count = 0;
+      for(const auto& entry : entries)
+        count += entry.second.count;
+      return count;
+    }
+
+    /**
+     * Writes a report of the allocations per option and state, sorted by their number.
+     * @param stream The stream that is written to.
+     */
+    void writeReport(std::ostream& stream) const
+    {
+      std::map<std::string, Entry> merged;
+      for(const auto& [names, entry] : entries)
+      {
+        Entry& sum = merged[names.first ? std::string(names.first) + '/' + (names.second ? names.second : "") : std::string("(outside of options)")];
+        sum.count += entry.count;
+        sum.bytes += entry.bytes;
+      }
+      std::vector<std::pair<std::string, Entry>> sorted(merged.begin(), merged.end());
+      std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {return a.second.count > b.second.count;});
+      stream << "frames: " << frames << ", allocations: " << getAllocations() << ", deallocations: " << frees << "\n\n"
+             << std::setw(12) << "allocations" << std::setw(14) << "bytes" << std::setw(14) << "per frame" << "  option/state\n";
+      for(const auto& [name, entry] : sorted)
+        stream << std::setw(12) << entry.count << std::setw(14) << entry.bytes
+               << std::setw(14) << std::fixed << std::setprecision(2) << (frames ? static_cast<double>(entry.count) / frames : 0.)
+               << "  " << name << '\n';
+    }
+  };
+}
+
+#ifdef CABSL_TRACK_ALLOCATIONS
+
+// Replacements of the global operators `new` and `delete` that report to the tracker.
+// They must only be defined in a single compilation unit.
+
+void* operator new(std::size_t size)
+{
+  void* p = std::malloc(size ? size : 1);
+  if(!p)
+    throw std::bad_alloc();
+  cabsl::AllocationTracker::allocated(size);
+  return p;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  void* p = std::malloc(size ? size : 1);
+  if(p)
+    cabsl::AllocationTracker::allocated(size);
+  return p;
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+  return operator new(size, tag);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  const std::size_t align = static_cast<std::size_t>(alignment);
+  void* p = std::aligned_alloc(align, (size + align - 1) / align * align);
+  if(!p)
+    throw std::bad_alloc();
+  cabsl::AllocationTracker::allocated(size);
+  return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return operator new(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+  if(p)
+  {
+    cabsl::AllocationTracker::freed();
+    std::free(p);
+  }
+}
+
+void operator delete[](void* p) noexcept
+{
+  operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  operator delete(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  operator delete(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+  operator delete(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+  operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+  operator delete(p);
+}
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * @file BehaviorGraph.h
+ *
+ * A description of the structure of a behavior that is written as a set of
+ * GraphViz files: one graph of all options and the calls between them and
+ * one graph for each option showing its states, its state transitions, and
+ * the sub-options called from its states. The structure of the graphs is
+ * the same as the one created by the script `bin/createGraphs`. It
+ * supplements the script rather than replacing it.
+ *
+ * In contrast to the script, the information is not scraped from the source
+ * code, but it is collected from the compiled behavior. The options and
+ * their states (with their types) are registered during static
+ * initialization, i.e. they are known without executing the behavior.
+ * State transitions and option calls are normal C++ control flow that
+ * cannot be registered that way. Therefore, they are taken from
+ * `cabsl::EdgeStatistics`, i.e. the graphs contain the transitions and calls
+ * that were actually observed while running the behavior. Transitions and
+ * calls that were never executed are missing, whereas the script shows all
+ * that are written in the source code. The program `example/graphs.cpp`
+ * collects them by replaying recorded games.
+ *
+ * Example:
+ *
+ *     cabsl::BehaviorGraph behaviorGraph;
+ *     Behavior::OptionInfos::describe(behaviorGraph);
+ *     behaviorGraph.addStatistics(edgeStatistics); // optional
+ *     behaviorGraph.write(".", "options");
+ *
+ * This writes `options.dot` and a file `<option>.dot` for each option that
+ * has states. They can be converted by calling `dot -Tsvg -O *.dot`.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "EdgeStatistics.h"
+
+namespace cabsl
+{
+  class BehaviorGraph
+  {
+  public:
+    /** The different types of states. Their order matches the one used in `Cabsl`. */
+    enum StateType
+    {
+      normalState,
+      initialState,
+      targetState,
+      abortedState
+    };
+
+  private:
+    /** A state of an option. */
+    struct State
+    {
+      std::string name; /**< The name of the state. */
+      StateType type; /**< The type of the state. */
+      int line; /**< The line in which the state was defined. Used to sort the states. */
+    };
+
+    /** An option with its states and the edges leaving them. */
+    struct Option
+    {
+      std::vector<State> states; /**< The states of the option. */
+      std::map<std::pair<std::string, std::string>, std::uint64_t> transitions; /**< The transitions with their counts, indexed by from- and to-state. */
+      std::map<std::pair<std::string, std::string>, std::uint64_t> calls; /**< The calls with their counts, indexed by state and sub-option. */
+    };
+
+    std::map<std::string, Option> options; /**< All options, indexed by their names. */
+
+    /**
+     * Creates a label for a node that is split into multiple lines at
+     * underscores and camel case humps.
+     * @param name The name of the node.
+     * @param separator The separator inserted between the parts.
+     * @return The label.
+     */
+    static std::string label(const std::string& name, const char* separator = "\\n")
+    {
+      std::string label;
+      for(std::size_t i = 0; i < name.size(); ++i)
+        if(name[i] == '_')
+          label += separator;
+        else
+        {
+          if(i > 0 && std::islower(static_cast<unsigned char>(name[i - 1])) && std::isupper(static_cast<unsigned char>(name[i])))
+            label += separator;
+          label += static_cast<char>(std::tolower(static_cast<unsigned char>(name[i])));
+        }
+      return label;
+    }
+
+    /**
+     * Writes the graph of all options and the calls between them.
+     * @param stream The stream that is written to.
+     * @param format The file format the graphs will be converted to (for links).
+     */
+    void writeOptions(std::ostream& stream, const std::string& format) const
+    {
+      stream << "digraph \"\" {\n"
+             << "  margin = 0;\n"
+             << "  node [shape = box, fontname = Arial, fontsize=9, fontcolor = \"#005A9C\", margin = 0.05];\n"
+             << "  edge [arrowsize=0.8];\n";
+      for(const auto& [name, option] : options)
+        stream << "  " << name << " [label=\"" << label(name) << "\", tooltip = \"option '" << name << "'\""
+               << (option.states.empty() ? "" : ", URL = \"file:" + name + "." + format + "\"") << "];\n";
+      for(const auto& [name, option] : options)
+      {
+        std::map<std::string, std::uint64_t> callees;
+        for(const auto& [call, count] : option.calls)
+          callees[call.second] += count;
+        for(const auto& [callee, count] : callees)
+          stream << name << " -> " << callee << " [tooltip = \"" << name << " -> " << callee << ": " << count << " times\"];\n";
+      }
+      stream << "}\n";
+    }
+
+    /**
+     * Writes the graph of a single option.
+     * @param stream The stream that is written to.
+     * @param name The name of the option.
+     * @param option The option.
+     * @param format The file format the graphs will be converted to (for links).
+     */
+    static void writeOption(std::ostream& stream, const std::string& name, const Option& option, const std::string& format)
+    {
+      static const char* shapes[] = {"circle", "Mcircle", "doublecircle", "doubleoctagon, regular = true"};
+      static const char* types[] = {"state", "initial_state", "target_state", "aborted_state"};
+      stream << "digraph \"\" {\n"
+             << "margin = 0;\n"
+             << "node [style = filled, fillcolor = white, fontname = Arial, fontsize=9, fontcolor = \"#005A9C\", margin = 0.05];\n"
+             << "ranksep = 0.4;\n"
+             << "nodesep = 0.3;\n"
+             << "edge [arrowsize=0.8];\n"
+             << "compound = true;\n"
+             << "subgraph cluster_ {\n"
+             << "label = \"option '" << label(name, " ") << "'\"\n"
+             << "tooltip = \"option '" << name << "'\"\n"
+             << "labeljust = l;\n"
+             << "style = filled;\n"
+             << "fillcolor = \"#F4F4F4\";\n"
+             << "fontname = Arial;\n"
+             << "fontsize=12;\n"
+             << "fontcolor = \"#005A9C\";\n";
+      for(const State& state : option.states)
+        stream << state.name << " [shape = " << shapes[state.type] << ", label = \"" << label(state.name)
+               << "\", tooltip = \"" << types[state.type] << " '" << state.name << "'\"];\n";
+      for(const auto& [transition, count] : option.transitions)
+        stream << transition.first << " -> " << transition.second << " [tooltip = \"" << transition.first << " -> " << transition.second
+               << ": " << count << " times\"];\n";
+      stream << "}\n";
+      std::set<std::string> callees;
+      for(const auto& [call, count] : option.calls)
+      {
+        stream << call.first << " -> option_" << call.second << " [color = \"#808080\", style = dashed, minlen = 2, tooltip = \""
+               << call.first << " -> " << call.second << ": " << count << " times\"];\n";
+        callees.insert(call.second);
+      }
+      for(const std::string& callee : callees)
+        stream << "option_" << callee << " [shape = rectangle, label = \"" << label(callee) << "\", tooltip = \"option '" << callee
+               << "'\", URL = \"file:" << callee << "." << format << "\"];\n";
+      stream << "}\n";
+    }
+
+  public:
+    /**
+     * Adds an option. This is only required for options without states that are never called.
+     * @param option The name of the option.
+     */
+    void addOption(const std::string& option)
+    {
+      options[option];
+    }
+
+    /**
+     * Adds a state to an option. States that were already added are ignored.
+     * @param option The name of the option.
+     * @param state The name of the state.
+     * @param type The type of the state.
+     * @param line The line in which the state is defined. The states are sorted by it.
+     */
+    void addState(const std::string& option, const std::string& state, StateType type, int line)
+    {
+      std::vector<State>& states = options[option].states;
+      if(std::find_if(states.begin(), states.end(), [&state](const State& s) {return s.name == state;}) == states.end())
+        states.insert(std::upper_bound(states.begin(), states.end(), line, [](int line, const State& s) {return line < s.line;}),
+                      State{state, type, line});
+    }
+
+    /**
+     * Adds a transition between two states of an option.
+     * @param option The name of the option.
+     * @param from The name of the state the transition starts in.
+     * @param to The name of the state the transition leads to.
+     * @param count How often was the transition observed?
+     */
+    void addTransition(const std::string& option, const std::string& from, const std::string& to, std::uint64_t count = 1)
+    {
+      options[option].transitions[{from, to}] += count;
+    }
+
+    /**
+     * Adds the call of a sub-option from a state of an option.
+     * @param option The name of the calling option.
+     * @param state The name of the state the call was made from.
+     * @param subOption The name of the option called.
+     * @param count How often was the call observed?
+     */
+    void addCall(const std::string& option, const std::string& state, const std::string& subOption, std::uint64_t count = 1)
+    {
+      options[option].calls[{state, subOption}] += count;
+      options[subOption];
+    }
+
+    /**
+     * Adds all transitions and calls observed by edge statistics.
+     * @param edgeStatistics The statistics.
+     */
+    void addStatistics(const EdgeStatistics& edgeStatistics)
+    {
+      std::stringstream stream;
+      edgeStatistics.write(stream);
+      for(std::string line; std::getline(stream, line);)
+      {
+        std::istringstream entry(line);
+        std::string type, option, first, second;
+        std::uint64_t count;
+        if(entry >> type >> option >> first >> second >> count)
+        {
+          if(type == "transition")
+            addTransition(option, first, second, count);
+          else if(type == "call")
+            addCall(option, first, second, count);
+        }
+      }
+    }
+
+    /**
+     * Writes the graphs in GraphViz's dot format, i.e. the graph of all
+     * options as well as a graph for each option that has states.
+     * @param directory The directory the files are written to.
+     * @param name The name of the graph of all options (without the extension ".dot").
+     * @param format The file format the graphs will be converted to. Required for the
+     *               links between the graphs.
+     * @return Could all files be written?
+     */
+    bool write(const std::string& directory, const std::string& name, const std::string& format = "svg") const
+    {
+      std::ofstream stream(directory + "/" + name + ".dot");
+      writeOptions(stream, format);
+      bool success = static_cast<bool>(stream);
+      for(const auto& [optionName, option] : options)
+        if(!option.states.empty())
+        {
+          std::ofstream optionStream(directory + "/" + optionName + ".dot");
+          writeOption(optionStream, optionName, option, format);
+          success &= static_cast<bool>(optionStream);
+        }
+      return success;
+    }
+  };
+}
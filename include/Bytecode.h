@@ -0,0 +1,1498 @@
+/**
+ * @file Bytecode.h
+ *
+ * A compiler that translates a subset of CABSL into a compact bytecode and
+ * an interpreter that executes it. This allows to exchange a behavior at
+ * runtime, e.g. for tuning or A/B experiments, without compiling C++ code.
+ *
+ * The subset accepted is still valid CABSL, i.e. the same source file can
+ * also be included into a behavior class and compiled natively:
+ *
+ *     <cabsl>      = { <option> }
+ *     <option>     = option '(' <C-ident> ')' '{' [ common_transition <block> ] { <state> } '}'
+ *     <state>      = ( initial_state | state | target_state | aborted_state ) '(' <C-ident> ')'
+ *                    '{' [ transition <block> ] [ action <block> ] '}'
+ *     <block>      = '{' { <statement> } '}'
+ *     <statement>  = <block>
+ *                  | if '(' <expr> ')' <statement> [ else <statement> ]
+ *                  | goto <C-ident> ';'
+ *                  | <C-ident> '(' ')' ';'
+ *                  | <C-ident> '=' <expr> ';'
+ *                  | ';'
+ *
+ * `goto` is only allowed in the common transition and in transition blocks.
+ * A call refers to another option of the program. An assignment writes an
+ * output symbol. Expressions support the C++ operators `||`, `&&`, `==`,
+ * `!=`, `<`, `<=`, `>`, `>=`, `+`, `-`, `*`, `/`, unary `!` and `-`,
+ * parentheses, numbers, `true`, `false`, `option_time`, `state_time`,
+ * `action_done`, `action_aborted`, and input symbols. All other identifiers
+ * are input symbols. Input and output symbols are bound by name to variables
+ * registered at the interpreter when a program is loaded. All computations
+ * are done with `double` values, i.e. in contrast to C++, there is no
+ * integer division. Options do not have parameters and `select_option` is
+ * not supported. Comments and preprocessor directives are ignored.
+ *
+ * The interpreter follows the semantics of the native macros, i.e. the
+ * contexts of the options, the state times, `action_done`, `action_aborted`,
+ * and the activation graph behave exactly the same, including the filter of
+ * the activation sink. However, options called
+ * are not executed recursively. Instead, the interpreter uses a flat,
+ * explicit call stack.
+ *
+ * Example:
+ *
+ *     cabsl::BytecodeProgram program;
+ *     if(!program.compile(source, "options.h"))
+ *       std::cerr << program.getError() << "\n";
+ *     cabsl::BytecodeInterpreter interpreter;
+ *     interpreter.addInput("ballDistance", &ballDistance);
+ *     interpreter.addOutput("speed", &speed);
+ *     if(!interpreter.load(program))
+ *       std::cerr << interpreter.getError() << "\n";
+ *     ...
+ *     interpreter.beginFrame(time);
+ *     interpreter.execute("play_soccer");
+ *     interpreter.endFrame();
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ActivationGraph.h"
+
+namespace cabsl
+{
+  class BytecodeProgram
+  {
+  public:
+    /**
+     * The instructions. Each instruction is a 32-bit word. The lower 8 bits
+     * contain the opcode, the upper 24 bits a signed operand.
+     */
+    enum Opcode : std::uint8_t
+    {
+      pushConstant, /**< Push the constant with the index given as operand. */
+      loadInput, /**< Push the value of the input symbol with the index given as operand. */
+      loadOptionTime, /**< Push `option_time`. */
+      loadStateTime, /**< Push `state_time`. */
+      loadActionDone, /**< Push `action_done`. */
+      loadActionAborted, /**< Push `action_aborted`. */
+      storeOutput, /**< Pop a value and write it to the output symbol with the index given as operand. */
+      negate, /**< Replace the top value by its negation. */
+      logicalNot, /**< Replace the top value by its logical negation. */
+      truth, /**< Replace the top value by 1 if it is not 0. Otherwise by 0. */
+      add, /**< Replace the two top values by their sum. */
+      subtract, /**< Replace the two top values by their difference. */
+      multiply, /**< Replace the two top values by their product. */
+      divide, /**< Replace the two top values by their quotient. */
+      less, /**< Replace the two top values by the result of `<`. */
+      lessEqual, /**< Replace the two top values by the result of `<=`. */
+      greater, /**< Replace the two top values by the result of `>`. */
+      greaterEqual, /**< Replace the two top values by the result of `>=`. */
+      equal, /**< Replace the two top values by the result of `==`. */
+      notEqual, /**< Replace the two top values by the result of `!=`. */
+      jump, /**< Continue at the address given as operand. */
+      jumpIfFalse, /**< Pop a value. If it is 0, continue at the address given as operand. */
+      jumpIfFalseOrPop, /**< If the top value is 0, continue at the address given as operand. Otherwise, pop it. */
+      jumpIfTrueOrPop, /**< If the top value is not 0, continue at the address given as operand. Otherwise, pop it. */
+      commonTransition, /**< Mark the begin of the common transition. */
+      enterState, /**< Push whether the state given as operand is the current one. */
+      transition, /**< Push whether the transition block can be executed. */
+      gotoState, /**< Switch to the state given as operand and continue at its beginning. */
+      action, /**< Add the option to the activation graph. */
+      call, /**< Call the option given as operand. */
+      ret /**< Return from the current option. */
+    };
+
+    /** The different types of states. Their order matches the one used in `Cabsl`. */
+    enum StateType : std::uint8_t
+    {
+      normalState,
+      initialState,
+      targetState,
+      abortedState
+    };
+
+    /** A state of an option. */
+    struct State
+    {
+      std::string name; /**< The name of the state. */
+      StateType type; /**< The type of the state. */
+      std::int32_t address; /**< The address of the code of the state. */
+    };
+
+    /** An option. */
+    struct Option
+    {
+      std::string name; /**< The name of the option. */
+      std::int32_t address; /**< The address of the code of the option. */
+      std::int32_t initialState; /**< The index of the initial state. */
+      std::vector<State> states; /**< The states of the option. */
+    };
+
+    std::vector<std::uint32_t> code; /**< The instructions of all options. */
+    std::vector<double> constants; /**< The constants used in expressions. */
+    std::vector<std::string> inputs; /**< The names of all input symbols used. */
+    std::vector<std::string> outputs; /**< The names of all output symbols used. */
+    std::vector<Option> options; /**< All options. */
+    std::int32_t maxStackSize = 0; /**< The maximum number of values on the stack when evaluating expressions. */
+
+  private:
+    /** A token of the source code. */
+    struct Token
+    {
+      enum Type {identifier, number, symbol, end} type; /**< The type of the token. */
+      std::string text; /**< The text of the token. */
+      double value; /**< The value of a number. */
+      int line; /**< The line the token starts in. */
+    };
+
+    /** An instruction the operand of which refers to a name that is resolved later. */
+    struct Reference
+    {
+      std::size_t address; /**< The address of the instruction. */
+      std::string name; /**< The name of the state or option referred to. */
+      int line; /**< The line of the reference (for error messages). */
+    };
+
+    /** The exception thrown by the compiler when it detects an error. */
+    struct Error
+    {
+      std::string message; /**< The error message. */
+    };
+
+    std::vector<Token> tokens; /**< The tokens of the source code being compiled. */
+    std::size_t next; /**< The index of the next token. */
+    std::string filename; /**< The name of the file compiled (for error messages). */
+    std::string error; /**< The last error that occurred. */
+    std::vector<Reference> gotos; /**< The goto statements of the option being compiled. */
+    std::vector<Reference> calls; /**< The calls of all options compiled. */
+    std::int32_t stackSize; /**< The number of values currently on the stack. */
+    bool inTransition; /**< Is the statement compiled part of a transition? */
+
+    /**
+     * Throws an error.
+     * @param line The line the error occurred in.
+     * @param message The error message.
+     */
+    [[noreturn]] void fail(int line, const std::string& message) const
+    {
+      throw Error{filename + ":" + std::to_string(line) + ": " + message};
+    }
+
+    /**
+     * Splits the source code into tokens.
+     * @param source The source code.
+     */
+    void tokenize(const std::string& source)
+    {
+      tokens.clear();
+      int line = 1;
+      bool lineStart = true;
+      for(std::size_t i = 0; i < source.size();)
+      {
+        const char c = source[i];
+        if(c == '\n')
+        {
+          ++line;
+          ++i;
+          lineStart = true;
+        }
+        else if(std::isspace(static_cast<unsigned char>(c)))
+          ++i;
+        else if(c == '#' && lineStart)
+        {
+          // Skip preprocessor directives including continuation lines.
+          while(i < source.size() && source[i] != '\n')
+            i += source[i] == '\\' && i + 1 < source.size() && source[i + 1] == '\n' ? (++line, 2) : 1;
+        }
+        else if(source.compare(i, 2, "//") == 0)
+          i = source.find('\n', i) == std::string::npos ? source.size() : source.find('\n', i);
+        else if(source.compare(i, 2, "/*") == 0)
+        {
+          const std::size_t end = source.find("*/", i + 2);
+          if(end == std::string::npos)
+            fail(line, "unterminated comment");
+          for(; i < end + 2; ++i)
+            line += source[i] == '\n' ? 1 : 0;
+        }
+        else
+        {
+          lineStart = false;
+          if(std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+          {
+            const std::size_t start = i;
+            while(i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_'))
+              ++i;
+            tokens.push_back({Token::identifier, source.substr(start, i - start), 0.0, line});
+          }
+          else if(std::isdigit(static_cast<unsigned char>(c)) || (c == '.' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1]))))
+          {
+            const char* start = source.c_str() + i;
+            char* end;
+            const double value = std::strtod(start, &end);
+            i += end - start;
+            if(i < source.size() && (source[i] == 'f' || source[i] == 'F'))
+              ++i;
+            tokens.push_back({Token::number, std::string(start, static_cast<std::size_t>(end - start)), value, line});
+          }
+          else
+          {
+            static const char* symbols[] = {"||", "&&", "==", "!=", "<=", ">=", "(", ")", "{", "}", ";", ",", "=", "<", ">", "+", "-", "*", "/", "!"};
+            const char* symbol = nullptr;
+            for(const char* s : symbols)
+              if(source.compare(i, std::char_traits<char>::length(s), s) == 0)
+              {
+                symbol = s;
+                break;
+              }
+            if(!symbol)
+              fail(line, std::string("unexpected character '") + c + "'");
+            tokens.push_back({Token::symbol, symbol, 0.0, line});
+            i += tokens.back().text.size();
+          }
+        }
+      }
+      tokens.push_back({Token::end, "end of file", 0.0, line});
+      next = 0;
+    }
+
+    /**
+     * Checks whether the next token has a certain text.
+     * @param text The text.
+     * @return Does the next token have this text?
+     */
+    bool peek(const char* text) const
+    {
+      return tokens[next].type != Token::end && tokens[next].text == text;
+    }
+
+    /**
+     * Consumes the next token if it has a certain text.
+     * @param text The text.
+     * @return Was the token consumed?
+     */
+    bool accept(const char* text)
+    {
+      if(peek(text))
+      {
+        ++next;
+        return true;
+      }
+      else
+        return false;
+    }
+
+    /**
+     * Consumes the next token, which must have a certain text.
+     * @param text The text.
+     */
+    void expect(const char* text)
+    {
+      if(!accept(text))
+        fail(tokens[next].line, std::string("expected '") + text + "' instead of '" + tokens[next].text + "'");
+    }
+
+    /**
+     * Consumes the next token, which must be an identifier.
+     * @return The identifier.
+     */
+    const Token& expectIdentifier()
+    {
+      if(tokens[next].type != Token::identifier)
+        fail(tokens[next].line, "expected identifier instead of '" + tokens[next].text + "'");
+      return tokens[next++];
+    }
+
+    /**
+     * Adds an instruction.
+     * @param opcode The opcode.
+     * @param operand The operand.
+     * @param stackChange How many values does the instruction add to the stack (negative if removed)?
+     * @return The address of the instruction.
+     */
+    std::size_t emit(Opcode opcode, std::int32_t operand = 0, int stackChange = 0)
+    {
+      if(operand < -(1 << 23) || operand >= 1 << 23)
+        fail(tokens[next].line, "program too large");
+      code.push_back(static_cast<std::uint32_t>(opcode) | static_cast<std::uint32_t>(operand) << 8);
+      stackSize += stackChange;
+      if(stackSize > maxStackSize)
+        maxStackSize = stackSize;
+      return code.size() - 1;
+    }
+
+    /**
+     * Sets the operand of an instruction.
+     * @param address The address of the instruction.
+     * @param operand The new operand.
+     */
+    void patch(std::size_t address, std::int32_t operand)
+    {
+      code[address] = (code[address] & 0xff) | static_cast<std::uint32_t>(operand) << 8;
+    }
+
+    /**
+     * Returns the index of a name in a list. If the name is not present, it is added.
+     * @param names The list.
+     * @param name The name.
+     * @return The index.
+     */
+    static std::int32_t indexOf(std::vector<std::string>& names, const std::string& name)
+    {
+      for(std::size_t i = 0; i < names.size(); ++i)
+        if(names[i] == name)
+          return static_cast<std::int32_t>(i);
+      names.push_back(name);
+      return static_cast<std::int32_t>(names.size() - 1);
+    }
+
+    /**
+     * Compiles a binary operator expression using precedence climbing.
+     * @param level The precedence level. 0 is `||`, 5 are unary operators.
+     */
+    void compileExpression(int level = 0)
+    {
+      static const struct {const char* symbol; Opcode opcode;} operators[][4] =
+      {
+        {{"||", jumpIfTrueOrPop}},
+        {{"&&", jumpIfFalseOrPop}},
+        {{"==", equal}, {"!=", notEqual}},
+        {{"<=", lessEqual}, {">=", greaterEqual}, {"<", less}, {">", greater}},
+        {{"+", add}, {"-", subtract}},
+        {{"*", multiply}, {"/", divide}}
+      };
+      if(level == 6)
+      {
+        compileUnary();
+        return;
+      }
+      compileExpression(level + 1);
+      for(bool found = true; found;)
+      {
+        found = false;
+        for(const auto& op : operators[level])
+          if(op.symbol && accept(op.symbol))
+          {
+            found = true;
+            if(level < 2)
+            {
+              // Short-circuit evaluation. The result is normalized to 0 or 1.
+              const std::size_t address = emit(op.opcode);
+              stackSize -= 1;
+              compileExpression(level + 1);
+              patch(address, static_cast<std::int32_t>(code.size()));
+              emit(truth);
+            }
+            else
+            {
+              compileExpression(level + 1);
+              emit(op.opcode, 0, -1);
+            }
+            break;
+          }
+      }
+    }
+
+    /** Compiles a unary expression or a primary expression. */
+    void compileUnary()
+    {
+      const Token& token = tokens[next];
+      if(accept("-"))
+      {
+        compileUnary();
+        emit(negate);
+      }
+      else if(accept("!"))
+      {
+        compileUnary();
+        emit(logicalNot);
+      }
+      else if(accept("("))
+      {
+        compileExpression();
+        expect(")");
+      }
+      else if(token.type == Token::number)
+      {
+        ++next;
+        constants.push_back(token.value);
+        emit(pushConstant, static_cast<std::int32_t>(constants.size() - 1), 1);
+      }
+      else
+      {
+        const std::string& name = expectIdentifier().text;
+        if(name == "true" || name == "false")
+        {
+          constants.push_back(name == "true" ? 1.0 : 0.0);
+          emit(pushConstant, static_cast<std::int32_t>(constants.size() - 1), 1);
+        }
+        else if(name == "option_time")
+          emit(loadOptionTime, 0, 1);
+        else if(name == "state_time")
+          emit(loadStateTime, 0, 1);
+        else if(name == "action_done")
+          emit(loadActionDone, 0, 1);
+        else if(name == "action_aborted")
+          emit(loadActionAborted, 0, 1);
+        else
+          emit(loadInput, indexOf(inputs, name), 1);
+      }
+    }
+
+    /** Compiles a statement. */
+    void compileStatement()
+    {
+      const Token& token = tokens[next];
+      if(peek("{"))
+        compileBlock();
+      else if(accept(";"))
+        ;
+      else if(accept("if"))
+      {
+        expect("(");
+        compileExpression();
+        expect(")");
+        const std::size_t skipThen = emit(jumpIfFalse, 0, -1);
+        compileStatement();
+        if(accept("else"))
+        {
+          const std::size_t skipElse = emit(jump);
+          patch(skipThen, static_cast<std::int32_t>(code.size()));
+          compileStatement();
+          patch(skipElse, static_cast<std::int32_t>(code.size()));
+        }
+        else
+          patch(skipThen, static_cast<std::int32_t>(code.size()));
+      }
+      else if(accept("goto"))
+      {
+        if(!inTransition)
+          fail(token.line, "goto outside of transition");
+        gotos.push_back({emit(gotoState), expectIdentifier().text, token.line});
+        expect(";");
+      }
+      else
+      {
+        const std::string& name = expectIdentifier().text;
+        if(accept("("))
+        {
+          expect(")");
+          calls.push_back({emit(call), name, token.line});
+        }
+        else
+        {
+          expect("=");
+          compileExpression();
+          emit(storeOutput, indexOf(outputs, name), -1);
+        }
+        expect(";");
+      }
+    }
+
+    /** Compiles a block of statements. */
+    void compileBlock()
+    {
+      expect("{");
+      while(!accept("}"))
+        compileStatement();
+    }
+
+    /** Compiles an option. */
+    void compileOption()
+    {
+      static const char* stateKeywords[] = {"state", "initial_state", "target_state", "aborted_state"};
+      const int line = tokens[next].line;
+      expect("option");
+      expect("(");
+      const Token& name = expectIdentifier();
+      if(!peek(")"))
+        fail(tokens[next].line, "options with parameters are not supported");
+      expect(")");
+      for(const Option& option : options)
+        if(option.name == name.text)
+          fail(name.line, "option '" + name.text + "' is defined twice");
+      Option option{name.text, static_cast<std::int32_t>(code.size()), -1, {}};
+      gotos.clear();
+      expect("{");
+      if(accept("common_transition"))
+      {
+        emit(commonTransition);
+        inTransition = true;
+        compileBlock();
+      }
+      while(!accept("}"))
+      {
+        const Token& keyword = expectIdentifier();
+        int type = 0;
+        while(type < 4 && keyword.text != stateKeywords[type])
+          ++type;
+        if(type == 4)
+          fail(keyword.line, "expected state instead of '" + keyword.text + "'");
+        expect("(");
+        const Token& stateName = expectIdentifier();
+        expect(")");
+        for(const State& state : option.states)
+          if(state.name == stateName.text)
+            fail(stateName.line, "state '" + stateName.text + "' is defined twice");
+        if(type == initialState)
+        {
+          if(option.initialState != -1)
+            fail(keyword.line, "option '" + option.name + "' has more than one initial state");
+          option.initialState = static_cast<std::int32_t>(option.states.size());
+        }
+        option.states.push_back({stateName.text, static_cast<StateType>(type), static_cast<std::int32_t>(code.size())});
+        emit(enterState, static_cast<std::int32_t>(option.states.size() - 1), 1);
+        const std::size_t skipState = emit(jumpIfFalse, 0, -1);
+        expect("{");
+        if(accept("transition"))
+        {
+          emit(transition, 0, 1);
+          const std::size_t skipTransition = emit(jumpIfFalse, 0, -1);
+          inTransition = true;
+          compileBlock();
+          patch(skipTransition, static_cast<std::int32_t>(code.size()));
+        }
+        if(accept("action"))
+        {
+          emit(action);
+          inTransition = false;
+          compileBlock();
+        }
+        expect("}");
+        patch(skipState, static_cast<std::int32_t>(code.size()));
+      }
+      emit(ret);
+      if(option.initialState == -1)
+        fail(line, "option '" + option.name + "' has no initial state");
+      for(const Reference& reference : gotos)
+      {
+        std::size_t i = 0;
+        while(i < option.states.size() && option.states[i].name != reference.name)
+          ++i;
+        if(i == option.states.size())
+          fail(reference.line, "unknown state '" + reference.name + "'");
+        patch(reference.address, static_cast<std::int32_t>(i));
+      }
+      options.push_back(option);
+    }
+
+  public:
+    /**
+     * Compiles source code. The previous contents of the program are replaced.
+     * @param source The source code.
+     * @param filename The name of the file the source code was read from (for error messages).
+     * @return Was the source code compiled successfully? Otherwise, `getError` describes the problem.
+     */
+    bool compile(const std::string& source, const std::string& filename = "<source>")
+    {
+      *this = BytecodeProgram();
+      this->filename = filename;
+      stackSize = 0;
+      try
+      {
+        tokenize(source);
+        while(tokens[next].type != Token::end)
+          compileOption();
+        for(const Reference& reference : calls)
+        {
+          std::size_t i = 0;
+          while(i < options.size() && options[i].name != reference.name)
+            ++i;
+          if(i == options.size())
+            fail(reference.line, "unknown option '" + reference.name + "'");
+          patch(reference.address, static_cast<std::int32_t>(i));
+        }
+      }
+      catch(const Error& e)
+      {
+        error = e.message;
+        code.clear();
+        options.clear();
+        return false;
+      }
+      tokens.clear();
+      calls.clear();
+      return true;
+    }
+
+    /**
+     * Writes the program in a binary format. Numbers are written in the byte
+     * order of the machine.
+     * @param stream The stream that is written to.
+     * @return Was the program written successfully?
+     */
+    bool write(std::ostream& stream) const
+    {
+      auto writeValue = [&stream](const auto& value) {stream.write(reinterpret_cast<const char*>(&value), sizeof(value));};
+      auto writeString = [&](const std::string& string)
+      {
+        writeValue(static_cast<std::uint32_t>(string.size()));
+        stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+      };
+      stream.write("CABSLBC1", 8);
+      writeValue(maxStackSize);
+      writeValue(static_cast<std::uint32_t>(code.size()));
+      stream.write(reinterpret_cast<const char*>(code.data()), static_cast<std::streamsize>(code.size() * sizeof(std::uint32_t)));
+      writeValue(static_cast<std::uint32_t>(constants.size()));
+      stream.write(reinterpret_cast<const char*>(constants.data()), static_cast<std::streamsize>(constants.size() * sizeof(double)));
+      for(const std::vector<std::string>* names : {&inputs, &outputs})
+      {
+        writeValue(static_cast<std::uint32_t>(names->size()));
+        for(const std::string& name : *names)
+          writeString(name);
+      }
+      writeValue(static_cast<std::uint32_t>(options.size()));
+      for(const Option& option : options)
+      {
+        writeString(option.name);
+        writeValue(option.address);
+        writeValue(option.initialState);
+        writeValue(static_cast<std::uint32_t>(option.states.size()));
+        for(const State& state : option.states)
+        {
+          writeString(state.name);
+          writeValue(state.type);
+          writeValue(state.address);
+        }
+      }
+      return static_cast<bool>(stream);
+    }
+
+    /**
+     * Reads a program in the binary format written by `write`. The previous
+     * contents of the program are replaced. Only the format is checked here.
+     * Whether the program can be executed safely is checked when it is loaded
+     * (see `verify`).
+     * @param stream The stream that is read from.
+     * @return Was the program read successfully?
+     */
+    bool read(std::istream& stream)
+    {
+      *this = BytecodeProgram();
+      auto readValue = [&stream](auto& value) {stream.read(reinterpret_cast<char*>(&value), sizeof(value));};
+      auto readSize = [&]
+      {
+        std::uint32_t size = 0;
+        readValue(size);
+        if(size >= 1u << 23) // more than any operand can address
+          stream.setstate(std::ios::failbit);
+        return stream ? size : 0;
+      };
+      auto readString = [&](std::string& string)
+      {
+        string.resize(readSize());
+        stream.read(string.data(), static_cast<std::streamsize>(string.size()));
+      };
+      char magic[8] = {0};
+      stream.read(magic, 8);
+      if(!stream || std::string(magic, 8) != "CABSLBC1")
+      {
+        error = "not a bytecode program";
+        return false;
+      }
+      readValue(maxStackSize);
+      code.resize(readSize());
+      stream.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(code.size() * sizeof(std::uint32_t)));
+      constants.resize(readSize());
+      stream.read(reinterpret_cast<char*>(constants.data()), static_cast<std::streamsize>(constants.size() * sizeof(double)));
+      for(std::vector<std::string>* names : {&inputs, &outputs})
+      {
+        names->resize(readSize());
+        for(std::string& name : *names)
+          readString(name);
+      }
+      options.resize(readSize());
+      for(Option& option : options)
+      {
+        readString(option.name);
+        readValue(option.address);
+        readValue(option.initialState);
+        option.states.resize(readSize());
+        for(State& state : option.states)
+        {
+          readString(state.name);
+          readValue(state.type);
+          readValue(state.address);
+        }
+      }
+      if(!stream)
+      {
+        error = "corrupted or truncated bytecode program";
+        *this = BytecodeProgram();
+        return false;
+      }
+      return true;
+    }
+
+    /**
+     * Checks whether the program can be executed safely, e.g. after it was
+     * read from a file that might be corrupted or edited by hand. All opcodes,
+     * operands, and addresses must be valid. Each instruction reachable from
+     * the beginning of an option must belong to this option only and must
+     * always be reached with the same number of values on the stack. Options
+     * must only be called and left with an empty stack and must not call
+     * themselves. The execution must neither run past the end of the code
+     * nor loop endlessly. Therefore, the instructions are followed for each
+     * value of the flag `transitionExecuted` and for the state entered by
+     * `goto`, because `transition` skips the transition block of a state that
+     * was just entered. `maxStackSize` is recomputed from the code.
+     * @return Is the program valid? Otherwise, `getError` describes the problem.
+     */
+    bool verify()
+    {
+      if(code.size() >= 1u << 23)
+      {
+        error = "invalid bytecode: program too large";
+        return false;
+      }
+
+      /** Is the value on top of the stack known, because it was pushed by `enterState` or `transition`? */
+      enum Top : std::uint8_t {unknown, knownFalse, knownTrue};
+
+      /** A situation in which an instruction can be executed. */
+      struct Situation
+      {
+        std::int32_t address; /**< The address of the instruction. */
+        std::int32_t depth; /**< The number of values on the stack. */
+        std::int32_t state; /**< The current state if it was set by `goto`. -1 if unknown. */
+        bool transitionExecuted; /**< The flag of the context of the option. */
+        Top top; /**< What is known about the value on top of the stack? */
+      };
+
+      /** A situation on the path currently checked and the situations that can follow it. */
+      struct Visit
+      {
+        std::uint64_t key; /**< The key of the situation in `visited`. */
+        Situation next[2]; /**< The situations that can follow. */
+        int count; /**< The number of entries in `next` not checked yet. */
+      };
+
+      const auto inRange = [](std::int32_t index, std::size_t size) {return index >= 0 && static_cast<std::size_t>(index) < size;};
+      std::int32_t maxSize = 0;
+      std::vector<std::int32_t> owners(code.size(), -1); // The index of the option each instruction belongs to.
+      std::vector<std::int32_t> depths(code.size(), 0); // The number of values on the stack at each instruction.
+      std::unordered_map<std::uint64_t, bool> visited; // The situations checked. True if they are on the path.
+      std::vector<Visit> path;
+      std::vector<std::vector<std::int32_t>> callees(options.size()); // The options called by each option.
+      std::vector<std::int32_t> callers(options.size(), 0); // The number of calls of each option.
+      for(std::size_t i = 0; i < options.size(); ++i)
+      {
+        const Option& option = options[i];
+        const auto fail = [&](std::int32_t address, const std::string& message)
+        {
+          error = "invalid bytecode in option '" + option.name + "'"
+                  + (address >= 0 ? " at address " + std::to_string(address) : std::string()) + ": " + message;
+          return false;
+        };
+
+        // Checks the instruction executed in a situation and adds the situation to the path.
+        const auto visit = [&](std::int32_t from, Situation situation)
+        {
+          const std::int32_t address = situation.address;
+          const std::int32_t depth = situation.depth;
+          if(!inRange(address, code.size()))
+            return fail(from, "address " + std::to_string(address) + " is outside of the code");
+          if(owners[address] == -1)
+          {
+            owners[address] = static_cast<std::int32_t>(i);
+            depths[address] = depth;
+          }
+          else if(owners[address] != static_cast<std::int32_t>(i))
+            return fail(from, "address " + std::to_string(address) + " belongs to another option");
+          else if(depths[address] != depth)
+            return fail(from, "unbalanced stack at address " + std::to_string(address));
+          const std::uint64_t key = (static_cast<std::uint64_t>(situation.state + 1) << 32)
+                                    | static_cast<std::uint64_t>(address) << 3 | (situation.transitionExecuted ? 4 : 0) | situation.top;
+          const auto found = visited.find(key);
+          if(found != visited.end())
+            return found->second ? fail(from, "endless loop") : true;
+
+          const std::int32_t operand = static_cast<std::int32_t>(code[address]) >> 8;
+          std::int32_t popped = 0; // The number of values the instruction requires on the stack.
+          std::int32_t change = 0; // The number of values added to the stack (negative if removed).
+          std::int32_t target = operand; // The address the instruction can jump to.
+          std::int32_t targetDepth = depth; // The number of values on the stack after jumping.
+          bool continues = true; // Can the execution continue at the next address?
+          bool jumps = false; // Can the execution continue at `target`?
+          Top top = unknown; // What is known about the value on top of the stack afterwards?
+          switch(code[address] & 0xff)
+          {
+            case pushConstant:
+              if(!inRange(operand, constants.size()))
+                return fail(address, "invalid constant");
+              change = 1;
+              break;
+            case loadInput:
+              if(!inRange(operand, inputs.size()))
+                return fail(address, "invalid input symbol");
+              change = 1;
+              break;
+            case loadOptionTime:
+            case loadStateTime:
+            case loadActionDone:
+            case loadActionAborted:
+              change = 1;
+              break;
+            case storeOutput:
+              if(!inRange(operand, outputs.size()))
+                return fail(address, "invalid output symbol");
+              popped = 1;
+              change = -1;
+              break;
+            case negate:
+            case logicalNot:
+            case truth:
+              popped = 1;
+              break;
+            case add:
+            case subtract:
+            case multiply:
+            case divide:
+            case less:
+            case lessEqual:
+            case greater:
+            case greaterEqual:
+            case equal:
+            case notEqual:
+              popped = 2;
+              change = -1;
+              break;
+            case jump:
+              continues = false;
+              jumps = true;
+              break;
+            case jumpIfFalse:
+              popped = 1;
+              change = -1;
+              targetDepth = depth - 1;
+              continues = situation.top != knownFalse;
+              jumps = situation.top != knownTrue;
+              break;
+            case jumpIfFalseOrPop:
+            case jumpIfTrueOrPop:
+              popped = 1;
+              change = -1;
+              jumps = true;
+              break;
+            case commonTransition:
+            case action:
+              break;
+            case enterState:
+              if(!inRange(operand, option.states.size()))
+                return fail(address, "invalid state");
+              if(situation.state != -1)
+                top = situation.state == operand ? knownTrue : knownFalse;
+              change = 1;
+              break;
+            case transition:
+              situation.transitionExecuted = !situation.transitionExecuted;
+              top = situation.transitionExecuted ? knownTrue : knownFalse;
+              change = 1;
+              break;
+            case gotoState:
+              if(!inRange(operand, option.states.size()))
+                return fail(address, "invalid state");
+              situation.state = operand;
+              situation.transitionExecuted = true;
+              target = option.states[operand].address;
+              continues = false;
+              jumps = true;
+              break;
+            case call:
+              if(!inRange(operand, options.size()))
+                return fail(address, "invalid option");
+              if(depth)
+                return fail(address, "call with values on the stack");
+              callees[i].push_back(operand);
+              ++callers[operand];
+              break;
+            case ret:
+              if(depth)
+                return fail(address, "return with values on the stack");
+              continues = false;
+              break;
+            default:
+              return fail(address, "invalid opcode " + std::to_string(code[address] & 0xff));
+          }
+          if(depth < popped)
+            return fail(address, "stack underflow");
+          if(depth + change > maxSize)
+            maxSize = depth + change;
+          visited[key] = true;
+          path.push_back({key, {}, 0});
+          Visit& added = path.back();
+          if(continues)
+            added.next[added.count++] = {address + 1, depth + change, situation.state, situation.transitionExecuted, top};
+          if(jumps)
+            added.next[added.count++] = {target, targetDepth, situation.state, situation.transitionExecuted, unknown};
+          return true;
+        };
+
+        if(!inRange(option.initialState, option.states.size()))
+          return fail(-1, "invalid initial state");
+        for(const State& state : option.states)
+          if(state.type > abortedState || !inRange(state.address, code.size()))
+            return fail(-1, "invalid state '" + state.name + "'");
+        if(!visit(-1, {option.address, 0, -1, false, unknown}))
+          return false;
+        while(!path.empty())
+          if(path.back().count)
+          {
+            const std::int32_t from = static_cast<std::int32_t>(path.back().key >> 3 & 0x7fffff);
+            const Situation next = path.back().next[--path.back().count];
+            if(!visit(from, next))
+              return false;
+          }
+          else
+          {
+            visited[path.back().key] = false;
+            path.pop_back();
+          }
+      }
+
+      // Options must not call themselves, not even indirectly, because each
+      // option has only a single context. Options that are not called by
+      // options remaining are removed until none are left.
+      std::vector<std::int32_t> pending;
+      for(std::size_t i = 0; i < options.size(); ++i)
+        if(!callers[i])
+          pending.push_back(static_cast<std::int32_t>(i));
+      std::size_t removed = 0;
+      while(!pending.empty())
+      {
+        const std::int32_t index = pending.back();
+        pending.pop_back();
+        ++removed;
+        for(const std::int32_t callee : callees[index])
+          if(!--callers[callee])
+            pending.push_back(callee);
+      }
+      if(removed < options.size())
+      {
+        error = "invalid bytecode: options are called recursively";
+        return false;
+      }
+      maxStackSize = maxSize;
+      return true;
+    }
+
+    /**
+     * Returns the description of the last error.
+     * @return The error message.
+     */
+    const std::string& getError() const {return error;}
+  };
+
+  class BytecodeInterpreter
+  {
+    /** The types of symbols supported. */
+    enum SymbolType {boolType, intType, unsignedType, floatType, doubleType};
+
+    /** A variable registered as a symbol. */
+    struct Symbol
+    {
+      void* address; /**< The address of the variable. */
+      SymbolType type; /**< The type of the variable. */
+    };
+
+    /** The context of an option. Corresponds to `Cabsl::OptionContext`. */
+    struct Context
+    {
+      std::int32_t state; /**< The index of the current state. */
+      std::int32_t stateName; /**< The index of the state reached in this frame (for activation graph). -1 if none yet. */
+      unsigned lastFrame = static_cast<unsigned>(-1); /**< The timestamp of the last frame in which this option was executed. */
+      unsigned optionStart; /**< The time when the option started to run (for `option_time`). */
+      unsigned stateStart; /**< The time when the current state started to run (for `state_time`). */
+      BytecodeProgram::StateType stateType; /**< The type of the current state in this option. */
+      BytecodeProgram::StateType subOptionStateType; /**< The type of the state of the last suboption executed. */
+      bool addedToGraph; /**< Was this option already added to the activation graph in this frame? */
+      bool transitionExecuted; /**< Has a transition already been executed? True after a state change. */
+      bool hasCommonTransition; /**< Does this option have a common transition? Is reset when entering the first state. */
+      unsigned filterVersion = 0; /**< The version of the activation sink's filter `acceptedByFilter` was determined for. */
+      bool acceptedByFilter = false; /**< Does the filter of the activation sink accept this option? */
+    };
+
+    /** An entry of the call stack. */
+    struct Frame
+    {
+      std::int32_t option; /**< The index of the option executed. */
+      std::int32_t returnAddress; /**< The address execution continues at in the caller. -1 for the root option. */
+    };
+
+    BytecodeProgram program; /**< The program loaded. */
+    std::unordered_map<std::string, Symbol> inputSymbols; /**< The input symbols registered, indexed by their names. */
+    std::unordered_map<std::string, Symbol> outputSymbols; /**< The output symbols registered, indexed by their names. */
+    std::unordered_map<std::string, std::int32_t> optionsByName; /**< The indices of the options, indexed by their names. */
+    std::vector<Symbol> inputs; /**< The input symbols in the order used by the program. */
+    std::vector<Symbol> outputs; /**< The output symbols in the order used by the program. */
+    std::vector<Context> contexts; /**< The contexts of all options. */
+    std::vector<Frame> stack; /**< The call stack. */
+    std::vector<double> values; /**< The stack used for evaluating expressions. */
+    ActivationSink* activationSink = nullptr; /**< The sink options and states are reported to, e.g. an activation graph. Can be zero if not set. */
+    bool recordingGraph = false; /**< Are options reported to the activation sink in the current frame? */
+    unsigned recordedFrames = 0; /**< The number of frames in which options could have been reported (for `Filter::interval`). */
+    unsigned triggeredFrames = 0; /**< The number of frames still recorded after the trigger of the filter fired. */
+    BytecodeProgram::StateType stateType = BytecodeProgram::normalState; /**< The state type of the last option called. */
+    unsigned lastFrameTime = 0; /**< The timestamp of the last time the behavior was executed. */
+    unsigned currentFrameTime = 0; /**< The timestamp of the current execution of the behavior. */
+    int depth = 0; /**< The depth level of the current option. Used for activation graph. */
+    std::string error; /**< The last error that occurred. */
+
+    /**
+     * Determines the type of a symbol.
+     * @tparam T The type of the variable.
+     * @return The type of the symbol.
+     */
+    template<typename T> static constexpr SymbolType typeOf()
+    {
+      static_assert(std::is_same<T, bool>::value || std::is_same<T, int>::value || std::is_same<T, unsigned>::value
+                    || std::is_same<T, float>::value || std::is_same<T, double>::value, "Unsupported symbol type");
+      return std::is_same<T, bool>::value ? boolType : std::is_same<T, int>::value ? intType
+             : std::is_same<T, unsigned>::value ? unsignedType : std::is_same<T, float>::value ? floatType : doubleType;
+    }
+
+    /**
+     * Binds the symbols of the program to registered variables.
+     * @param names The names of the symbols used by the program.
+     * @param registered The variables registered.
+     * @param symbols The bound symbols in the order used by the program.
+     * @param kind The kind of the symbols (for the error message).
+     * @return Could all symbols be bound?
+     */
+    bool bind(const std::vector<std::string>& names, const std::unordered_map<std::string, Symbol>& registered,
+              std::vector<Symbol>& symbols, const char* kind)
+    {
+      symbols.clear();
+      for(const std::string& name : names)
+      {
+        const auto symbol = registered.find(name);
+        if(symbol == registered.end())
+        {
+          error = std::string("unknown ") + kind + " symbol '" + name + "'";
+          return false;
+        }
+        symbols.push_back(symbol->second);
+      }
+      return true;
+    }
+
+    /**
+     * Starts recording the activation graph if entering a state fires the
+     * trigger of the filter. Corresponds to `Cabsl::OptionExecution::checkTrigger`.
+     * @param option The option that enters the state.
+     * @param state The state.
+     */
+    void checkTrigger(const BytecodeProgram::Option& option, const BytecodeProgram::State& state)
+    {
+      if(activationSink->getFilter().triggers(option.name.c_str(), state.name.c_str()))
+      {
+        recordingGraph = true;
+        triggeredFrames = activationSink->getFilter().triggerFrames;
+      }
+    }
+
+    /**
+     * Starts the execution of an option. Corresponds to the constructor of `Cabsl::OptionExecution`.
+     * @param option The index of the option.
+     * @return The context of the option.
+     */
+    Context& enter(std::int32_t option)
+    {
+      Context& context = contexts[option];
+      if(context.lastFrame != lastFrameTime && context.lastFrame != currentFrameTime)
+      {
+        context.optionStart = currentFrameTime;
+        context.stateStart = currentFrameTime;
+        context.state = program.options[option].initialState;
+        context.stateType = BytecodeProgram::initialState;
+        context.stateName = -1;
+        context.subOptionStateType = BytecodeProgram::normalState;
+        if(activationSink && !activationSink->getFilter().triggerOption.empty())
+          checkTrigger(program.options[option], program.options[option].states[context.state]);
+      }
+      context.addedToGraph = false;
+      context.transitionExecuted = false;
+      context.hasCommonTransition = false;
+      ++depth;
+      if(activationSink && activationSink->reportsCalls())
+        activationSink->beginCall(program.options[option].name.c_str());
+      return context;
+    }
+
+    /**
+     * Ends the execution of an option. Corresponds to the destructor of `Cabsl::OptionExecution`.
+     * @param option The index of the option.
+     */
+    void leave(std::int32_t option)
+    {
+      Context& context = contexts[option];
+      addToActivationGraph(option, context);
+      context.lastFrame = currentFrameTime;
+      if(activationSink && activationSink->reportsCalls())
+        activationSink->endCall();
+      --depth;
+      context.subOptionStateType = stateType;
+      stateType = context.stateType;
+    }
+
+    /**
+     * Is an option reported to the activation sink in this frame? This is the
+     * case if there is one, the current frame is recorded, and the filter
+     * accepts the option at its depth. Corresponds to `Cabsl::OptionExecution::isRecorded`.
+     * @param option The index of the option.
+     * @param context The context of the option.
+     * @return Is the option recorded?
+     */
+    bool isRecorded(std::int32_t option, Context& context) const
+    {
+      if(!activationSink || !recordingGraph)
+        return false;
+      const ActivationSink::Filter& filter = activationSink->getFilter();
+      if(filter.maxDepth && depth > filter.maxDepth)
+        return false;
+      if(context.filterVersion != activationSink->getFilterVersion())
+      {
+        context.acceptedByFilter = filter.accepts(program.options[option].name);
+        context.filterVersion = activationSink->getFilterVersion();
+      }
+      return context.acceptedByFilter;
+    }
+
+    /**
+     * Adds an option to the activation graph if it has not been added yet.
+     * @param option The index of the option.
+     * @param context The context of the option.
+     */
+    void addToActivationGraph(std::int32_t option, Context& context)
+    {
+      if(!context.addedToGraph)
+      {
+        if(isRecorded(option, context))
+        {
+          const BytecodeProgram::Option& o = program.options[option];
+          activationSink->enterOption(o.name.c_str(), depth, currentFrameTime - context.optionStart);
+          activationSink->enterState(context.stateName >= 0 ? o.states[context.stateName].name.c_str() : "",
+                                     currentFrameTime - context.stateStart);
+        }
+        context.addedToGraph = true;
+      }
+    }
+
+  public:
+    /**
+     * Registers a variable as input symbol.
+     * @tparam T The type of the variable: bool, int, unsigned, float, or double.
+     * @param name The name of the symbol.
+     * @param address The address of the variable.
+     */
+    template<typename T> void addInput(const std::string& name, const T* address)
+    {
+      inputSymbols[name] = {const_cast<T*>(address), typeOf<T>()};
+    }
+
+    /**
+     * Registers a variable as output symbol.
+     * @tparam T The type of the variable: bool, int, unsigned, float, or double.
+     * @param name The name of the symbol.
+     * @param address The address of the variable.
+     */
+    template<typename T> void addOutput(const std::string& name, T* address)
+    {
+      outputSymbols[name] = {address, typeOf<T>()};
+    }
+
+    /**
+     * Sets the sink the options and states executed in each frame are reported to,
+     * e.g. an activation graph.
+     * @param activationSink The sink. Switched off if it is zero.
+     */
+    void setActivationGraph(ActivationSink* activationSink)
+    {
+      this->activationSink = activationSink;
+    }
+
+    /**
+     * Loads a program. All options start from scratch. The symbols must have been registered before.
+     * Programs that cannot be executed safely are rejected (see `BytecodeProgram::verify`).
+     * @param program The program.
+     * @return Was the program loaded successfully? Otherwise, `getError` describes the problem.
+     */
+    bool load(const BytecodeProgram& program)
+    {
+      BytecodeProgram verified = program;
+      if(!verified.verify())
+      {
+        error = verified.getError();
+        return false;
+      }
+      std::vector<Symbol> inputs, outputs;
+      if(!bind(program.inputs, inputSymbols, inputs, "input") || !bind(program.outputs, outputSymbols, outputs, "output"))
+        return false;
+      this->program = std::move(verified);
+      this->inputs = inputs;
+      this->outputs = outputs;
+      optionsByName.clear();
+      for(std::size_t i = 0; i < program.options.size(); ++i)
+        optionsByName[program.options[i].name] = static_cast<std::int32_t>(i);
+      contexts.assign(program.options.size(), Context());
+      stack.reserve(program.options.size() + 1);
+      values.resize(static_cast<std::size_t>(this->program.maxStackSize) + 1);
+      return true;
+    }
+
+    /**
+     * Must be called at the beginning of each behavior execution cycle even if no option is called.
+     * @param frameTime The current time in ms.
+     */
+    void beginFrame(unsigned frameTime)
+    {
+      currentFrameTime = frameTime;
+      if(activationSink)
+      {
+        const ActivationSink::Filter& filter = activationSink->getFilter();
+        recordingGraph = recordedFrames++ % std::max(filter.interval, 1u) == 0;
+        if(!filter.triggerOption.empty())
+        {
+          recordingGraph &= triggeredFrames > 0;
+          if(triggeredFrames)
+            --triggeredFrames;
+        }
+        activationSink->beginFrame(frameTime, recordingGraph);
+      }
+    }
+
+    /** Must be called at the end of each behavior execution cycle even if no option is called. */
+    void endFrame()
+    {
+      lastFrameTime = currentFrameTime;
+      if(activationSink)
+        activationSink->endFrame();
+    }
+
+    /**
+     * Determines the index of an option.
+     * @param name The name of the option.
+     * @return The index or -1 if the option does not exist.
+     */
+    std::int32_t getOption(const std::string& name) const
+    {
+      const auto option = optionsByName.find(name);
+      return option == optionsByName.end() ? -1 : option->second;
+    }
+
+    /**
+     * Executes an option as a root.
+     * @param root The name of the option.
+     * @return Was the option executed, i.e. does it exist?
+     */
+    bool execute(const std::string& root)
+    {
+      return execute(getOption(root));
+    }
+
+    /**
+     * Executes an option as a root.
+     * @param root The index of the option.
+     * @return Was the option executed, i.e. is the index valid?
+     */
+    bool execute(std::int32_t root)
+    {
+      if(root < 0 || root >= static_cast<std::int32_t>(program.options.size()))
+        return false;
+
+      const std::uint32_t* code = program.code.data();
+      const double* constants = program.constants.data();
+      const BytecodeProgram::Option* option = &program.options[root];
+      Context* context = &enter(root);
+      stack.push_back({root, -1});
+      double* top = values.data(); // Points to the top value. values[0] is never used.
+      std::int32_t pc = option->address;
+      for(;;)
+      {
+        const std::uint32_t instruction = code[pc++];
+        const std::int32_t operand = static_cast<std::int32_t>(instruction) >> 8;
+        switch(static_cast<BytecodeProgram::Opcode>(instruction & 0xff))
+        {
+          case BytecodeProgram::pushConstant:
+            *++top = constants[operand];
+            break;
+          case BytecodeProgram::loadInput:
+          {
+            const Symbol& symbol = inputs[operand];
+            switch(symbol.type)
+            {
+              case boolType: *++top = *static_cast<const bool*>(symbol.address) ? 1.0 : 0.0; break;
+              case intType: *++top = *static_cast<const int*>(symbol.address); break;
+              case unsignedType: *++top = *static_cast<const unsigned*>(symbol.address); break;
+              case floatType: *++top = *static_cast<const float*>(symbol.address); break;
+              case doubleType: *++top = *static_cast<const double*>(symbol.address); break;
+            }
+            break;
+          }
+          case BytecodeProgram::loadOptionTime:
+            *++top = static_cast<int>(currentFrameTime - context->optionStart);
+            break;
+          case BytecodeProgram::loadStateTime:
+            *++top = static_cast<int>(currentFrameTime - context->stateStart);
+            break;
+          case BytecodeProgram::loadActionDone:
+            *++top = context->subOptionStateType == BytecodeProgram::targetState ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::loadActionAborted:
+            *++top = context->subOptionStateType == BytecodeProgram::abortedState ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::storeOutput:
+          {
+            const Symbol& symbol = outputs[operand];
+            const double value = *top--;
+            switch(symbol.type)
+            {
+              case boolType: *static_cast<bool*>(symbol.address) = value != 0.0; break;
+              case intType: *static_cast<int*>(symbol.address) = static_cast<int>(value); break;
+              case unsignedType: *static_cast<unsigned*>(symbol.address) = static_cast<unsigned>(value); break;
+              case floatType: *static_cast<float*>(symbol.address) = static_cast<float>(value); break;
+              case doubleType: *static_cast<double*>(symbol.address) = value; break;
+            }
+            break;
+          }
+          case BytecodeProgram::negate:
+            *top = -*top;
+            break;
+          case BytecodeProgram::logicalNot:
+            *top = *top == 0.0 ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::truth:
+            *top = *top != 0.0 ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::add:
+            --top;
+            *top += top[1];
+            break;
+          case BytecodeProgram::subtract:
+            --top;
+            *top -= top[1];
+            break;
+          case BytecodeProgram::multiply:
+            --top;
+            *top *= top[1];
+            break;
+          case BytecodeProgram::divide:
+            --top;
+            *top /= top[1];
+            break;
+          case BytecodeProgram::less:
+            --top;
+            *top = *top < top[1] ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::lessEqual:
+            --top;
+            *top = *top <= top[1] ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::greater:
+            --top;
+            *top = *top > top[1] ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::greaterEqual:
+            --top;
+            *top = *top >= top[1] ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::equal:
+            --top;
+            *top = *top == top[1] ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::notEqual:
+            --top;
+            *top = *top != top[1] ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::jump:
+            pc = operand;
+            break;
+          case BytecodeProgram::jumpIfFalse:
+            if(*top-- == 0.0)
+              pc = operand;
+            break;
+          case BytecodeProgram::jumpIfFalseOrPop:
+            if(*top == 0.0)
+              pc = operand;
+            else
+              --top;
+            break;
+          case BytecodeProgram::jumpIfTrueOrPop:
+            if(*top != 0.0)
+              pc = operand;
+            else
+              --top;
+            break;
+          case BytecodeProgram::commonTransition:
+            context->hasCommonTransition = true;
+            break;
+          case BytecodeProgram::enterState:
+            context->hasCommonTransition = false;
+            if(context->state == operand)
+            {
+              context->stateName = operand;
+              *++top = 1.0;
+            }
+            else
+              *++top = 0.0;
+            break;
+          case BytecodeProgram::transition:
+            *++top = (context->transitionExecuted ^= true) ? 1.0 : 0.0;
+            break;
+          case BytecodeProgram::gotoState:
+          {
+            const BytecodeProgram::State& state = option->states[operand];
+            context->transitionExecuted = true;
+            if(context->state != operand)
+            {
+              context->state = operand;
+              context->stateStart = currentFrameTime;
+              context->stateType = state.type;
+              if(activationSink && !activationSink->getFilter().triggerOption.empty())
+                checkTrigger(*option, state);
+            }
+            pc = state.address;
+            break;
+          }
+          case BytecodeProgram::action:
+            addToActivationGraph(stack.back().option, *context);
+            break;
+          case BytecodeProgram::call:
+            stack.push_back({operand, pc});
+            option = &program.options[operand];
+            context = &enter(operand);
+            pc = option->address;
+            break;
+          case BytecodeProgram::ret:
+          {
+            const Frame frame = stack.back();
+            leave(frame.option);
+            stack.pop_back();
+            if(stack.empty())
+              return true;
+            option = &program.options[stack.back().option];
+            context = &contexts[stack.back().option];
+            pc = frame.returnAddress;
+            break;
+          }
+        }
+      }
+    }
+
+    /**
+     * Returns the description of the last error.
+     * @return The error message.
+     */
+    const std::string& getError() const {return error;}
+  };
+}
@@ -94,6 +94,26 @@
  * for that state. If it has, the block is still executed, but neither the
  * `option_time` nor the `state_time` are increased.
  *
+ * The instrumentation of the behavior, i.e. the support for `Tracer`,
+ * `Profiler`, `PerfCounters`, `AllocationTracker`, `LatencyHistograms`,
+ * `EdgeStatistics`, and `BehaviorGraph`, is only available if
+ * `CABSL_INSTRUMENTATION` is defined before this file is included. Otherwise,
+ * neither their headers are included nor are their hooks executed, which
+ * keeps compiling and executing the behavior cheap. The symbol must be
+ * defined consistently in all files of the behavior.
+ *
+ * The definitions and variables of an option are stored inside its context
+ * if they fit into `CABSL_INLINE_STRUCT_SIZE` bytes (64 by default).
+ * Otherwise, they are allocated on the heap. This symbol must also be
+ * defined consistently.
+ *
+ * Options that are implemented in a separate file can also be compiled
+ * into shared libraries (modules) that are loaded, replaced, and unloaded
+ * at runtime by a `ModuleLoader` (see "ModuleLoader.h"). The files of a
+ * module must be compiled with `CABSL_MODULE` defined. Otherwise, the
+ * implementation linked into the program is executed as long as no module
+ * replaces it.
+ *
  * If Microsoft Visual Studio is used and options are included from separate
  * files, the following preprocessor code might be added before including
  * this file. `Class` has to be replaced by the template parameter of `Cabsl`:
@@ -107,29 +127,290 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <sstream>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include "ActivationGraph.h"
 #include "InFileStream.h"
+#include "Probes.h"
+#ifdef CABSL_INSTRUMENTATION
+#include <chrono>
+#include "AllocationTracker.h"
+#include "BehaviorGraph.h"
+#include "EdgeStatistics.h"
+#include "LatencyHistograms.h"
+#include "PerfCounters.h"
+#include "Profiler.h"
+#include "Tracer.h"
+#endif
 
 /** Reject Microsoft's traditional preprocessor. */
 #if defined _MSC_VER && (!defined _MSVC_TRADITIONAL || _MSVC_TRADITIONAL)
 #error "This code requires the standard preprocessor (/Zc:preprocessor)."
 #endif
 
+#ifndef CABSL_INLINE_STRUCT_SIZE
+#define CABSL_INLINE_STRUCT_SIZE 64
+#endif
+
 namespace cabsl
 {
   /**
-   * Base class for helper structures that makes sure that the
-   * destructor is virtual.
+   * Stores the structure of definitions or variables of an option. Structures
+   * that fit into the buffer are constructed in place, so accessing them does
+   * not follow a pointer to a separate allocation. Larger structures are
+   * allocated on the heap. Since the type of the structure is only known to
+   * the option, it is destroyed, saved, and restored through functions that
+   * are set when it is created. Trivially destructible structures stored in
+   * place are not destroyed at all.
    */
-  struct StructBase
+  class StructStorage
   {
-    virtual ~StructBase() = default;
+    /** The functions that handle a certain type of structure. */
+    struct Functions
+    {
+      void (*destroy)(void* object); /**< Destroys the structure. nullptr if nothing has to be done. */
+      void (*save)(const void* object, std::vector<char>& data); /**< Appends the structure to a checkpoint. */
+      void (*restore)(void* object, const char* data, size_t size); /**< Restores the structure from a checkpoint. */
+    };
+
+    /**
+     * Is a structure of type T stored in the buffer?
+     * @tparam T The type of the structure.
+     */
+    template<typename T> static constexpr bool isInline = sizeof(T) <= CABSL_INLINE_STRUCT_SIZE && alignof(T) <= alignof(std::max_align_t);
+
+    /**
+     * Destroys a structure of type T.
+     * @tparam T The type of the structure.
+     * @param object The structure.
+     */
+    template<typename T> static void destroyStruct(void* object)
+    {
+      if constexpr(isInline<T>)
+        static_cast<T*>(object)->~T();
+      else
+        delete static_cast<T*>(object);
+    }
+
+    /**
+     * Appends a structure of type T to a checkpoint if it is a structure of variables.
+     * @tparam T The type of the structure.
+     * @param object The structure.
+     * @param data The data of the checkpoint.
+     */
+    template<typename T> static void saveStruct(const void* object, std::vector<char>& data)
+    {
+      if constexpr(requires(const T& t) {t._save(data);})
+        static_cast<const T*>(object)->_save(data);
+    }
+
+    /**
+     * Restores a structure of type T from a checkpoint if it is a structure of variables.
+     * @tparam T The type of the structure.
+     * @param object The structure.
+     * @param data The data written by `save`.
+     * @param size The number of bytes written by `save`.
+     */
+    template<typename T> static void restoreStruct(void* object, const char* data, size_t size)
+    {
+      if constexpr(requires(T& t) {t._restore(data, size);})
+        static_cast<T*>(object)->_restore(data, size);
+    }
+
+    /**
+     * The functions for a structure of type T. Only structures of variables can be
+     * saved and restored.
+     * @tparam T The type of the structure.
+     */
+    template<typename T> static constexpr Functions functions =
+    {
+      isInline<T> && std::is_trivially_destructible<T>::value ? nullptr : &destroyStruct<T>,
+      &saveStruct<T>,
+      &restoreStruct<T>
+    };
+
+    alignas(std::max_align_t) char buffer[CABSL_INLINE_STRUCT_SIZE]; /**< The structure if it fits. */
+    void* heap = nullptr; /**< The structure if it does not fit into the buffer. */
+    const Functions* handler = nullptr; /**< The functions for the structure. nullptr if there is none. */
+
+  public:
+    StructStorage() = default;
+    StructStorage(const StructStorage&) = delete;
+    StructStorage& operator=(const StructStorage&) = delete;
+
+    /** The destructor destroys the structure. */
+    ~StructStorage() {reset();}
+
+    /**
+     * Is there a structure?
+     * @return Was a structure created?
+     */
+    explicit operator bool() const {return handler != nullptr;}
+
+    /**
+     * Creates a value-initialized structure. There must not be one yet.
+     * @tparam T The type of the structure.
+     * @return The structure.
+     */
+    template<typename T> T* create()
+    {
+      T* object;
+      if constexpr(isInline<T>)
+        object = new(buffer) T();
+      else
+        heap = object = new T();
+      handler = &functions<T>;
+      return object;
+    }
+
+    /**
+     * Returns the structure. It must have been created with the same type.
+     * @tparam T The type of the structure.
+     * @return The structure.
+     */
+    template<typename T> T* get()
+    {
+      if constexpr(isInline<T>)
+        return std::launder(reinterpret_cast<T*>(buffer));
+      else
+        return static_cast<T*>(heap);
+    }
+
+    /** Destroys the structure if there is one. */
+    void reset()
+    {
+      if(handler && handler->destroy)
+        handler->destroy(heap ? heap : buffer);
+      heap = nullptr;
+      handler = nullptr;
+    }
+
+    /**
+     * Appends the members of the structure that are trivially copyable to a
+     * checkpoint. There must be a structure.
+     * @param data The data of the checkpoint.
+     */
+    void save(std::vector<char>& data) const
+    {
+      handler->save(heap ? heap : buffer, data);
+    }
+
+    /**
+     * Restores the members that were written by `save`. Members not found with
+     * the same size keep their values. There must be a structure.
+     * @param data The data written by `save`.
+     * @param size The number of bytes written by `save`.
+     */
+    void restore(const char* data, size_t size)
+    {
+      handler->restore(heap ? heap : buffer, data, size);
+    }
   };
 
+  /**
+   * Computes the identifier of a state from the names of its option and of the
+   * state itself (FNV-1a). It is evaluated at compile time, so it does not change
+   * if the code around the state is edited. A leading underscore of the option
+   * name is ignored, because it is added to the functions of options with
+   * parameters. The identifier is positive, because 0 marks the initial state.
+   * @param option The name of the option.
+   * @param state The name of the state.
+   * @return The identifier of the state.
+   */
+  constexpr int stateId(const char* option, const char* state)
+  {
+    std::uint32_t hash = 2166136261u;
+    for(const char* p = option + (*option == '_' ? 1 : 0); *p; ++p)
+      hash = (hash ^ static_cast<unsigned char>(*p)) * 16777619u;
+    hash = (hash ^ static_cast<unsigned char>('.')) * 16777619u;
+    for(const char* p = state; *p; ++p)
+      hash = (hash ^ static_cast<unsigned char>(*p)) * 16777619u;
+    hash &= 0x7fffffff;
+    return hash ? static_cast<int>(hash) : 1;
+  }
+
+  /**
+   * Mixes a value into a frame signature.
+   * @param signature The signature so far.
+   * @param value The value that is added.
+   * @return The new signature.
+   */
+  constexpr std::uint64_t mixSignature(std::uint64_t signature, std::uint64_t value)
+  {
+    signature = (signature ^ value) * 0x9e3779b97f4a7c15ull;
+    return signature ^ signature >> 29;
+  }
+
+  /**
+   * Appends a member of a structure to a checkpoint if its type is trivially
+   * copyable. The member is stored as its name, its size, and its bytes.
+   * @param data The data of the checkpoint.
+   * @param name The name of the member.
+   * @param value The value of the member.
+   */
+  template<typename T> void saveMember(std::vector<char>& data, const char* name, const T& value)
+  {
+    if constexpr(std::is_trivially_copyable<T>::value)
+    {
+      const std::uint32_t sizes[2] = {static_cast<std::uint32_t>(std::strlen(name)), static_cast<std::uint32_t>(sizeof(T))};
+      data.insert(data.end(), reinterpret_cast<const char*>(sizes), reinterpret_cast<const char*>(sizes + 2));
+      data.insert(data.end(), name, name + sizes[0]);
+      data.insert(data.end(), reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value + 1));
+    }
+  }
+
+  /**
+   * Restores a member of a structure written by `saveMember`.
+   * @param data The data written by `saveMember` for all members of the structure.
+   * @param size The number of bytes written.
+   * @param name The name of the member.
+   * @param value The member that is set if it is found with the same size.
+   */
+  template<typename T> void restoreMember(const char* data, size_t size, const char* name, T& value)
+  {
+    if constexpr(std::is_trivially_copyable<T>::value)
+    {
+      const char* end = data + size;
+      std::uint32_t sizes[2];
+      for(const char* p = data; p + sizeof(sizes) <= end; p += sizeof(sizes) + sizes[0] + sizes[1])
+      {
+        std::memcpy(sizes, p, sizeof(sizes));
+        if(p + sizeof(sizes) + sizes[0] + sizes[1] > end)
+          break;
+        if(sizes[1] == sizeof(T) && std::strlen(name) == sizes[0] && std::memcmp(p + sizeof(sizes), name, sizes[0]) == 0)
+          std::memcpy(&value, p + sizeof(sizes) + sizes[0], sizeof(T));
+      }
+    }
+  }
+
+  /**
+   * The options and states a module implements. The types of the entries
+   * are erased, because they depend on the behavior class.
+   */
+  struct ModuleInfo
+  {
+    std::vector<const void*> options; /**< The implementations of the options (`Cabsl::OptionImplementation`). */
+    std::vector<const void*> states; /**< The states of these options (`Cabsl::StateDescriptor`). */
+    void (*connect)(void* optionsByName) = nullptr; /**< Lets the module use the options registered by the program. */
+  };
+
+#ifdef CABSL_MODULE
+  inline ModuleInfo moduleInfo; /**< The options and states implemented by this module. */
+#endif
+
+  template<typename CabslBehavior> class ModuleLoader;
+
   /**
    * The base class for CABSL behaviors.
    * Note: Private variables that cannot be declared as private start with an
@@ -167,8 +448,8 @@ namespace cabsl
         abortedState
       };
 
-      int state; /**< The state currently selected. This is actually the line number in which the state was declared. */
-      const char* stateName; /**< The name of the state (for activation graph). */
+      int state; /**< The identifier of the state currently selected (see `stateId`). 0 for the initial state. */
+      const char* stateName = nullptr; /**< The name of the state (for activation graph). */
       unsigned lastFrame = static_cast<unsigned>(-1); /**< The timestamp of the last frame in which this option was executed (except for the initial state when called from `select_option`). */
       unsigned lastSelectFrame = static_cast<unsigned>(-1); /**< The timestamp of the last frame in which this option was executed (in any case). */
       unsigned optionStart; /**< The time when the option started to run (for `option_time`). */
@@ -178,15 +459,12 @@ namespace cabsl
       bool addedToGraph; /**< Was this option already added to the activation graph in this frame? */
       bool transitionExecuted; /**< Has a transition already been executed? True after a state change. */
       bool hasCommonTransition; /**< Does this option have a common transition? Is reset when entering the first state. */
-      StructBase* defs = nullptr; /**< Option configuration definitions. */
-      StructBase* vars = nullptr; /**< Option variables. */
-
-      /** Destructor. */
-      ~OptionContext()
-      {
-        delete defs;
-        delete vars;
-      }
+      int optionId = 0; /**< The identifier of the option in frame signatures. 0 until it is needed first. */
+      unsigned filterVersion = 0; /**< The version of the activation graph filter `acceptedByFilter` was determined for. */
+      bool acceptedByFilter = false; /**< Does the filter of the activation graph accept this option? */
+      StructStorage defs; /**< Option configuration definitions. */
+      StructStorage vars; /**< Option variables. */
+      std::vector<char> restoredVars; /**< Variables restored from a checkpoint. They are applied when the variables are created. */
     };
 
     /**
@@ -207,7 +485,8 @@ namespace cabsl
       const char* optionName; /**< The name of the option (for activation graph). */
       Cabsl* instance; /**< The object that encapsulates the behavior. */
       bool fromSelect; /**< Option is called from `select_option`. */
-      mutable std::vector<std::string> arguments; /**< Argument names and their values. */
+      mutable std::vector<std::pair<const char*, std::string>> arguments; /**< Argument names and their values until they are passed to the activation sink. */
+      mutable std::uint64_t argumentSignature = 0; /**< The signature of the arguments (if they are signed). */
 
     public:
       OptionContext& context; /**< The context of the state. */
@@ -228,6 +507,12 @@ namespace cabsl
           context.stateStart = instance->_currentFrameTime; // initial state started now
           context.state = 0; // initial state is always marked with a 0
           context.stateType = OptionContext::initialState;
+          context.stateName = nullptr; // not known before the initial state is reached
+          if(instance->activationSink && instance->activationSink->getFilter().triggerOption == optionName)
+          {
+            const StateDescriptor* initialState = OptionInfos::findState(optionName, 0);
+            checkTrigger(initialState ? initialState->name : "");
+          }
         }
         if(context.lastSelectFrame != instance->lastFrameTime && context.lastSelectFrame != instance->_currentFrameTime)
           context.subOptionStateType = OptionContext::normalState; // reset `action_done` and `action_aborted`
@@ -235,6 +520,22 @@ namespace cabsl
         context.transitionExecuted = false; // no transition executed yet
         context.hasCommonTransition = false; // until one is found, it is assumed that there is no common transition
         ++instance->depth; // increase depth counter for activation graph
+        if(instance->activationSink && instance->activationSink->reportsCalls())
+          instance->activationSink->beginCall(optionName);
+        _CABSL_PROBE(option_entry, optionName, context.stateName, instance->depth, instance->_currentFrameTime);
+#ifdef CABSL_INSTRUMENTATION
+        if(instance->allocationTracker)
+          instance->allocationTracker->enter(optionName, &context.stateName);
+        AllocationTracker::Suspension suspension(instance->allocationTracker); // allocations of the instrumentation are not counted
+        if(instance->traceBuffer)
+          instance->traceBuffer->begin(optionName);
+        if(instance->profiler)
+          instance->profiler->enter(optionName);
+        if(instance->perfCounters)
+          instance->perfCounters->enter();
+        if(instance->edgeStatistics)
+          instance->edgeStatistics->enter(optionName, &context.stateName);
+#endif
       }
 
       /**
@@ -248,17 +549,48 @@ namespace cabsl
           context.lastFrame = instance->_currentFrameTime; // Remember that this option was called in this frame
         }
         context.lastSelectFrame = instance->_currentFrameTime; // Remember that this option was called in this frame (even in `select_option`/`initial_state`)
+        _CABSL_PROBE(option_exit, optionName, context.stateName, instance->depth, instance->_currentFrameTime);
+        if(instance->activationSink && instance->activationSink->reportsCalls())
+          instance->activationSink->endCall();
         --instance->depth; // decrease depth counter for activation graph
         context.subOptionStateType = instance->stateType; // remember the state type of the last sub option called
         instance->stateType = context.stateType; // publish the state type of this option, so the caller can grab it
+#ifdef CABSL_INSTRUMENTATION
+        if(instance->allocationTracker)
+          instance->allocationTracker->exit();
+        AllocationTracker::Suspension suspension(instance->allocationTracker); // allocations of the instrumentation are not counted
+        if(instance->edgeStatistics)
+          instance->edgeStatistics->exit(context.stateType == OptionContext::initialState);
+        if(instance->perfCounters)
+          instance->perfCounters->exit(optionName, context.stateName);
+        if(instance->profiler)
+          instance->profiler->exit();
+        if(instance->traceBuffer)
+          instance->traceBuffer->end(context.stateName);
+#endif
+      }
+
+      /**
+       * Starts recording the activation graph if entering a state fires the
+       * trigger of the filter.
+       * @param stateName The name of the state this option enters.
+       */
+      void checkTrigger(const char* stateName) const
+      {
+        if(instance->activationSink->getFilter().triggers(optionName, stateName))
+        {
+          instance->recordingGraph = true;
+          instance->triggeredFrames = instance->activationSink->getFilter().triggerFrames;
+        }
       }
 
       /**
        * The method is executed whenever the state is changed.
        * @param newState The new state to which it was changed.
+       * @param stateName The name of the new state.
        * @param stateType The type of the new state.
        */
-      void updateState(int newState, typename OptionContext::StateType stateType) const
+      void updateState(int newState, const char* stateName, typename OptionContext::StateType stateType) const
       {
         assert(context.hasCommonTransition != context.transitionExecuted); // `[common_]transition` is missing
         context.transitionExecuted = true; // a transition was executed, do not execute another one
@@ -267,13 +599,24 @@ namespace cabsl
           context.state = newState;
           context.stateStart = instance->_currentFrameTime; // state started now
           context.stateType = stateType; // remember type of this state
+          _CABSL_PROBE(state_transition, optionName, stateName, instance->depth, instance->_currentFrameTime);
+          if(instance->activationSink && !instance->activationSink->getFilter().triggerOption.empty())
+            checkTrigger(stateName);
+#ifdef CABSL_INSTRUMENTATION
+          AllocationTracker::Suspension suspension(instance->allocationTracker); // allocations of the instrumentation are not counted
+          if(instance->traceBuffer)
+            instance->traceBuffer->transition(stateName);
+          if(instance->edgeStatistics)
+            instance->edgeStatistics->transition(context.stateName, stateName);
+#endif
         }
       }
 
       /**
-       * Adds a string description containing the current value of an argument to the list of arguments.
-       * The description is only added if the argument is streamable.
+       * Adds the current value of an argument as text to the list of arguments.
+       * The value is only added if the argument is streamable.
        * @tparam U The type of the argument.
+       * @param name The declaration of the argument. Its name is the part after the type.
        * @param value The current value of the argument.
        */
       template<typename U> typename std::enable_if<isStreamable<U>::value>::type addArgument(const char* name, const U& value) const
@@ -281,25 +624,83 @@ namespace cabsl
         name += 1 + static_cast<int>(std::string(name).find_last_of(" )"));
         OutStringStream stream;
         stream << value;
-        arguments.emplace_back(name + (" = " + stream.str()));
+        arguments.emplace_back(name, stream.str());
       }
 
       /** Does not write the argument to a stream, because it is not streamable. */
       template<typename U> typename std::enable_if<!isStreamable<U>::value>::type addArgument(const char*, const U&) const {}
 
+      /**
+       * Is this option added to the activation graph in this frame? This is the
+       * case if there is one, the current frame is recorded, and the filter
+       * accepts the option at its depth.
+       * @return Is the option recorded?
+       */
+      bool isRecorded() const
+      {
+        if(!instance->activationSink || !instance->recordingGraph)
+          return false;
+        const ActivationSink::Filter& filter = instance->activationSink->getFilter();
+        if(filter.maxDepth && instance->depth > filter.maxDepth)
+          return false;
+        if(context.filterVersion != instance->activationSink->getFilterVersion())
+        {
+          context.acceptedByFilter = filter.accepts(optionName);
+          context.filterVersion = instance->activationSink->getFilterVersion();
+        }
+        return context.acceptedByFilter;
+      }
+
+      /**
+       * Are the values of arguments and variables added to the activation graph?
+       * If not, they are not streamed at all.
+       * @return Is this option recorded?
+       */
+      bool describesArguments() const {return isRecorded();}
+
+      /**
+       * Adds the value of an argument to the frame signature if arguments are signed.
+       * Only arguments the bytes of which represent their values are considered, i.e.
+       * numbers, enums, and structures of them without padding.
+       * @tparam U The type of the argument.
+       * @param value The current value of the argument.
+       */
+      template<typename U> void signArgument(const U& value) const
+      {
+        if constexpr(std::has_unique_object_representations<U>::value || std::is_floating_point<U>::value)
+          if(instance->signArguments)
+          {
+            std::uint64_t bits = 0;
+            for(size_t i = 0; i < sizeof(U); i += sizeof(bits))
+            {
+              std::memcpy(&bits, reinterpret_cast<const char*>(&value) + i, sizeof(U) - i < sizeof(bits) ? sizeof(U) - i : sizeof(bits));
+              argumentSignature = mixSignature(argumentSignature, bits);
+            }
+          }
+      }
+
       /**
        * The method adds information about the current option and state to the activation graph.
        * It suppresses adding it twice in the same frame.
        */
       void addToActivationGraph() const
       {
-        if(!context.addedToGraph && instance->activationGraph)
+        if(!context.addedToGraph)
         {
-          instance->activationGraph->graph.emplace_back(optionName, instance->depth,
-                                                        context.stateName,
-                                                        instance->_currentFrameTime - context.optionStart,
-                                                        instance->_currentFrameTime - context.stateStart,
-                                                        arguments);
+          if(!context.optionId)
+            context.optionId = stateId(optionName, "");
+          instance->signature = mixSignature(mixSignature(mixSignature(instance->signature,
+                                                                       static_cast<std::uint64_t>(context.optionId) << 32 | static_cast<unsigned>(instance->depth)),
+                                                          static_cast<unsigned>(context.state)),
+                                             argumentSignature);
+          if(isRecorded())
+          {
+            ActivationSink& sink = *instance->activationSink;
+            sink.enterOption(optionName, instance->depth, instance->_currentFrameTime - context.optionStart);
+            sink.enterState(context.stateName ? context.stateName : "", instance->_currentFrameTime - context.stateStart);
+            for(const std::pair<const char*, std::string>& argument : arguments)
+              sink.addArgument(argument.first, argument.second);
+          }
           context.addedToGraph = true;
         }
       }
@@ -327,15 +728,41 @@ namespace cabsl
       {}
     };
 
+    /** A class to store information about a state. */
+    struct StateDescriptor
+    {
+      const char* option; /**< The name of the function that implements the option. Might be prefixed by an underscore. */
+      const char* name; /**< The name of the state. */
+      typename OptionContext::StateType stateType; /**< The type of the state. */
+      int id; /**< The identifier of the state (see `stateId`). 0 for the initial state. */
+      int line; /**< The line in which the state is defined. */
+    };
+
+    /** An implementation of an option provided by a module. */
+    struct OptionImplementation
+    {
+      const char* name; /**< The name of the option. */
+      void (CabslBehavior::*function)(); /**< The method that is entered when the option is called. Its actual signature is erased. */
+      size_t offsetOfContext; /**< The memory offset of the context within the behavior class. */
+    };
+
   public:
     /** A class that collects information about all options in the behavior. */
     class OptionInfos
     {
     private:
       static std::unordered_map<std::string, const OptionDescriptor*>* optionsByName; /**< All argumentless options, indexed by their names. */
-      static std::vector<void (*)()>* initHandlers; /**< All initialization handlers for options with definitions. */
+      static std::vector<const OptionDescriptor*>* options; /**< All options, including the ones with arguments. */
+      static std::vector<void (*)(CabslBehavior*)>* initHandlers; /**< All initialization handlers for options with definitions. */
+      static std::vector<const StateDescriptor*>* states; /**< All states of all options. */
+      static std::unordered_map<std::string, std::vector<const StateDescriptor*>>* stateTables; /**< The states of each option sorted by their lines, indexed by the names of the options. */
+      static std::unordered_map<std::string, std::atomic<const OptionImplementation*>>* implementations; /**< Implementations of options provided by modules, indexed by the names of the options. */
+
+      friend class Cabsl;
+      template<typename> friend class ModuleLoader;
 
     public:
+#ifndef CABSL_MODULE
       /** The constructor prepares the collection of information if this has not been done yet. */
       OptionInfos()
       {
@@ -347,10 +774,28 @@ namespace cabsl
       ~OptionInfos()
       {
         delete optionsByName;
+        delete options;
         delete initHandlers;
+        delete states;
+        delete stateTables;
+        delete implementations;
         optionsByName = nullptr;
+        options = nullptr;
         initHandlers = nullptr;
+        states = nullptr;
+        stateTables = nullptr;
+        implementations = nullptr;
       }
+#else
+      /**
+       * A module uses the options registered by the program that loaded it.
+       * @param optionsByName All argumentless options of the program.
+       */
+      static void connect(void* optionsByName)
+      {
+        OptionInfos::optionsByName = static_cast<std::unordered_map<std::string, const OptionDescriptor*>*>(optionsByName);
+      }
+#endif
 
       /**
        * The method prepares the collection of information about all options in optionByIndex
@@ -368,31 +813,149 @@ namespace cabsl
        * The method adds information about an option to the collections.
        * It will be called from the constructors of static objects created for each
        * option.
-       * This method is only called for options without arguments, because only they
-       * can be called externally.
+       * Options with arguments are registered without an option method, because
+       * they cannot be called externally. They are only listed for checkpoints.
        * @param descriptor A description of an option.
        */
       static void add(const OptionDescriptor& descriptor)
       {
+#ifdef CABSL_MODULE
+        return; // A module uses the options of the program.
+#endif
         if(!optionsByName)
           init();
+        if(!options)
+          options = new std::vector<const OptionDescriptor*>;
 
         assert(optionsByName);
-        if(optionsByName->find(descriptor.name) == optionsByName->end()) // only register once
+        if(descriptor.option && optionsByName->find(descriptor.name) == optionsByName->end()) // only register once
           (*optionsByName)[descriptor.name] = &descriptor;
+        if(!findOption(descriptor.name))
+          options->push_back(&descriptor);
+      }
+
+      /**
+       * The method searches for an option by its name.
+       * @param name The name of the option.
+       * @return The description of the option or `nullptr` if it does not exist.
+       */
+      static const OptionDescriptor* findOption(const char* name)
+      {
+        if(options)
+          for(const OptionDescriptor* descriptor : *options)
+            if(!std::strcmp(descriptor->name, name))
+              return descriptor;
+        return nullptr;
+      }
+
+      /**
+       * Returns the states of an option. Their indices are dense and do not change
+       * while the program is running, so they can index arrays of data per state.
+       * @param option The name of the option.
+       * @return The states sorted by the lines in which they are defined or
+       *         `nullptr` if the option has no states.
+       */
+      static const std::vector<const StateDescriptor*>* getStateTable(const std::string& option)
+      {
+        if(stateTables)
+        {
+          const auto table = stateTables->find(option);
+          if(table != stateTables->end())
+            return &table->second;
+        }
+        return nullptr;
+      }
+
+      /**
+       * The method searches for a state of an option by its identifier.
+       * @param option The name of the option.
+       * @param id The identifier of the state. 0 is the initial state.
+       * @return The description of the state or `nullptr` if it does not exist.
+       */
+      static const StateDescriptor* findState(const std::string& option, int id)
+      {
+        if(const std::vector<const StateDescriptor*>* table = getStateTable(option))
+          for(const StateDescriptor* descriptor : *table)
+            if(descriptor->id == id)
+              return descriptor;
+        return nullptr;
+      }
+
+      /**
+       * The method searches for a state of an option by its name.
+       * @param option The name of the option.
+       * @param name The name of the state.
+       * @return The description of the state or `nullptr` if it does not exist.
+       */
+      static const StateDescriptor* findState(const std::string& option, const char* name)
+      {
+        if(const std::vector<const StateDescriptor*>* table = getStateTable(option))
+          for(const StateDescriptor* descriptor : *table)
+            if(!std::strcmp(descriptor->name, name))
+              return descriptor;
+        return nullptr;
       }
 
       /**
        * The method registers a handler to initialize definitions.
        * @param initHandler The address of the handler.
        */
-      static void add(void (*initHandler)())
+      static void add(void (*initHandler)(CabslBehavior*))
       {
+#ifdef CABSL_MODULE
+        return; // A module initializes its definitions when they are used first.
+#endif
         if(!initHandlers)
-          initHandlers = new std::vector<void (*)()>;
+          initHandlers = new std::vector<void (*)(CabslBehavior*)>;
         initHandlers->push_back(initHandler);
       }
 
+      /**
+       * The method registers a state. It will be called during static initialization
+       * for each state defined.
+       * @param descriptor A description of the state.
+       */
+      static void add(const StateDescriptor& descriptor)
+      {
+#ifdef CABSL_MODULE
+        moduleInfo.states.push_back(&descriptor);
+        return;
+#endif
+        if(!states)
+          states = new std::vector<const StateDescriptor*>;
+        states->push_back(&descriptor);
+
+        if(!stateTables)
+          stateTables = new std::unordered_map<std::string, std::vector<const StateDescriptor*>>;
+        std::vector<const StateDescriptor*>& table = (*stateTables)[descriptor.option + (*descriptor.option == '_' ? 1 : 0)];
+#ifndef NDEBUG
+        for(const StateDescriptor* other : table)
+          assert(other->id != descriptor.id || !std::strcmp(other->name, descriptor.name)); // Rename one of the states if their identifiers collide
+#endif
+        auto position = table.end(); // keep the table sorted by lines
+        while(position != table.begin() && descriptor.line < (*(position - 1))->line)
+          --position;
+        table.insert(position, &descriptor);
+      }
+
+#ifdef CABSL_INSTRUMENTATION
+      /**
+       * The method adds all options and states registered to a graph.
+       * @param graph The graph the options and states are added to.
+       */
+      static void describe(BehaviorGraph& graph)
+      {
+        if(optionsByName)
+          for(const auto& [name, descriptor] : *optionsByName)
+            if(descriptor->option)
+              graph.addOption(name);
+        if(states)
+          for(const StateDescriptor* descriptor : *states)
+            graph.addState(descriptor->option + (*descriptor->option == '_' ? 1 : 0), descriptor->name,
+                           static_cast<BehaviorGraph::StateType>(descriptor->stateType), descriptor->line);
+      }
+#endif
+
       /**
        * The method executes a certain option. Note that only argumentless options can be
        * executed.
@@ -430,12 +993,31 @@ namespace cabsl
         return false;
       }
 
-      /** Executes all handlers that initialize the definitions. */
-      static void executeInitHandlers()
+      /**
+       * Returns the slot that contains the implementation of an option provided
+       * by a module. The slot is created if it does not exist yet. It is empty
+       * as long as the implementation linked into the program is used.
+       * @param option The name of the option.
+       * @return The slot. Its address does not change.
+       */
+      static std::atomic<const OptionImplementation*>& implementation(const std::string& option)
+      {
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!implementations)
+          implementations = new std::unordered_map<std::string, std::atomic<const OptionImplementation*>>;
+        return (*implementations)[option];
+      }
+
+      /**
+       * Executes all handlers that initialize the definitions.
+       * @param behavior The behavior instance the definitions of which are initialized.
+       */
+      static void executeInitHandlers(CabslBehavior* behavior)
       {
         if(initHandlers)
-          for(void (*initHandler)() : *initHandlers)
-            initHandler();
+          for(void (*initHandler)(CabslBehavior*) : *initHandlers)
+            initHandler(behavior);
       }
     };
 
@@ -459,27 +1041,133 @@ namespace cabsl
       RegisterFunction() {static_cast<void>(&registrar);}
     };
 
+    /**
+     * A template class for registering a state during static initialization.
+     * The static member is initialized by calling a function object that
+     * returns the description of the state. Since the function object can be
+     * the type of a lambda defined in the function that implements an option,
+     * each state gets its own instantiation.
+     * @tparam Function The type of the function object returning the description.
+     */
+    template<typename Function> struct RegisterState
+    {
+      static inline const bool registered = (OptionInfos::add(Function()()), true); /**< Registers the state when initialized. */
+    };
+
     template<void(*function)()> class OptionInfo : public OptionContext, public RegisterFunction<function> {};
 
   private:
+    template<typename> friend class ModuleLoader;
+
+    static constexpr char checkpointMagic[] = "CABSLCP1"; /**< The identifier at the beginning of each checkpoint. */
     static OptionInfos collectOptions; /**< This global instantiation collects data about all options. */
     typename OptionContext::StateType stateType = OptionContext::normalState; /**< The state type of the last option called. */
     unsigned lastFrameTime = 0; /**< The timestamp of the last time the behavior was executed. */
     int depth = 0; /**< The depth level of the current option. Used for activation graph. */
-    ActivationGraph* activationGraph; /**< The activation graph for debug output. Can be zero if not set. */
+    ActivationSink* activationSink; /**< The sink options and states are reported to, e.g. an activation graph. Can be zero if not set. */
+    bool recordingGraph = false; /**< Are options reported to the activation sink in the current frame? */
+    unsigned recordedFrames = 0; /**< The number of frames in which the activation graph could have been recorded (for `Filter::interval`). */
+    unsigned triggeredFrames = 0; /**< The number of frames still recorded after the trigger of the filter fired. */
+    std::uint64_t signature = 0; /**< The signature of the current frame computed so far. */
+    std::uint64_t frameSignature = 0; /**< The signature of the last frame completed. */
+    bool signArguments = false; /**< Are the values of arguments included in frame signatures? */
+#ifdef CABSL_INSTRUMENTATION
+    Tracer::Buffer* traceBuffer = nullptr; /**< The buffer option executions are traced to. Can be zero if not set. */
+    Profiler* profiler = nullptr; /**< The profiler that aggregates statistics about option executions. Can be zero if not set. */
+    PerfCounters* perfCounters = nullptr; /**< The hardware performance counters measured per option. Can be zero if not set. */
+    AllocationTracker* allocationTracker = nullptr; /**< The tracker that attributes heap allocations to options. Can be zero if not set. */
+    EdgeStatistics* edgeStatistics = nullptr; /**< The statistics about transitions and calls actually executed. Can be zero if not set. */
+    LatencyHistograms* latencyHistograms = nullptr; /**< The histograms of frame and root option durations. Can be zero if not set. */
+    std::chrono::steady_clock::time_point frameStart; /**< When did the current frame start? Only set if `latencyHistograms` is set. */
+#endif
     bool definitionsInitialized = false; /**< Were the definitions already initialized? */
 
+    /**
+     * Returns the context of an option in this behavior.
+     * @param descriptor The description of the option.
+     * @return The context.
+     */
+    OptionContext& getContext(const OptionDescriptor& descriptor)
+    {
+      return *reinterpret_cast<OptionContext*>(reinterpret_cast<char*>(static_cast<CabslBehavior*>(this)) + descriptor.offsetOfContext);
+    }
+
+    /**
+     * Returns the context of an option in this behavior.
+     * @param descriptor The description of the option.
+     * @return The context.
+     */
+    const OptionContext& getContext(const OptionDescriptor& descriptor) const
+    {
+      return const_cast<Cabsl*>(this)->getContext(descriptor);
+    }
+
+    /**
+     * Appends a value to a checkpoint.
+     * @param data The data of the checkpoint.
+     * @param value The value. Its bytes are appended.
+     */
+    template<typename T> static void writeCheckpoint(std::vector<char>& data, T value)
+    {
+      data.insert(data.end(), reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value + 1));
+    }
+
+    /**
+     * Appends a string to a checkpoint. Its length is stored first.
+     * @param data The data of the checkpoint.
+     * @param value The string.
+     */
+    static void writeCheckpoint(std::vector<char>& data, const char* value)
+    {
+      const std::uint32_t size = static_cast<std::uint32_t>(std::strlen(value));
+      writeCheckpoint(data, size);
+      data.insert(data.end(), value, value + size);
+    }
+
+    /**
+     * Reads a value from a checkpoint.
+     * @param data The current position in the checkpoint. It is advanced.
+     * @param end The end of the checkpoint.
+     * @param value The value read.
+     * @return Was the value present?
+     */
+    template<typename T> static bool readCheckpoint(const char*& data, const char* end, T& value)
+    {
+      if(static_cast<size_t>(end - data) < sizeof(T))
+        return false;
+      std::memcpy(&value, data, sizeof(T));
+      data += sizeof(T);
+      return true;
+    }
+
+    /**
+     * Reads a string from a checkpoint.
+     * @param data The current position in the checkpoint. It is advanced.
+     * @param end The end of the checkpoint.
+     * @param value The string read.
+     * @return Was the string present?
+     */
+    static bool readCheckpoint(const char*& data, const char* end, std::string& value)
+    {
+      std::uint32_t size;
+      if(!readCheckpoint(data, end, size) || static_cast<size_t>(end - data) < size)
+        return false;
+      value.assign(data, size);
+      data += size;
+      return true;
+    }
+
   protected:
-    static thread_local Cabsl* _theInstance; /**< The instance of this behavior used. */
+    static thread_local Cabsl* _theInstance; /**< The instance of this behavior executed between `beginFrame` and `endFrame`. Options do not use it anymore. It is only kept for compatibility. */
     unsigned _currentFrameTime = 0; /**< The timestamp of the last time the behavior was executed. */
 
     /**
      * Constructor.
-     * @param activationGraph When set, the activation graph will be filled with the
-     *                        options and states executed in each frame.
+     * @param activationSink When set, the options and states executed in each frame
+     *                       are reported to it, e.g. to fill an activation graph.
      */
-    Cabsl(ActivationGraph* activationGraph = nullptr) :
-      activationGraph(activationGraph)
+    Cabsl(ActivationSink* activationSink = nullptr) :
+      activationSink(activationSink)
     {
       static_cast<void>(&collectOptions); // Enforce linking of this global object
     }
@@ -492,12 +1180,31 @@ namespace cabsl
     void beginFrame(unsigned frameTime)
     {
       _currentFrameTime = frameTime;
-      if(activationGraph)
-        activationGraph->graph.clear();
+      signature = 0;
+#ifdef CABSL_INSTRUMENTATION
+      if(latencyHistograms)
+        frameStart = std::chrono::steady_clock::now();
+#endif
+      if(activationSink)
+      {
+        const ActivationSink::Filter& filter = activationSink->getFilter();
+        recordingGraph = recordedFrames++ % (filter.interval ? filter.interval : 1u) == 0;
+        if(!filter.triggerOption.empty())
+        {
+          recordingGraph &= triggeredFrames > 0;
+          if(triggeredFrames)
+            --triggeredFrames;
+        }
+        activationSink->beginFrame(frameTime, recordingGraph);
+      }
+#ifdef CABSL_INSTRUMENTATION
+      if(allocationTracker)
+        allocationTracker->beginFrame(); // started last, so only the behavior is tracked
+#endif
       _theInstance = this;
       if(!definitionsInitialized)
       {
-        OptionInfos::executeInitHandlers();
+        OptionInfos::executeInitHandlers(static_cast<CabslBehavior*>(this));
         definitionsInitialized = true;
       }
     }
@@ -509,7 +1216,16 @@ namespace cabsl
      */
     void execute(const std::string& root)
     {
-      OptionInfos::execute(static_cast<CabslBehavior*>(this), root);
+#ifdef CABSL_INSTRUMENTATION
+      if(latencyHistograms)
+      {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        OptionInfos::execute(static_cast<CabslBehavior*>(this), root);
+        latencyHistograms->recordRoot(root, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+      }
+      else
+#endif
+        OptionInfos::execute(static_cast<CabslBehavior*>(this), root);
     }
 
     /** Must be called at the end of each behavior execution cycle even if no option is called. */
@@ -517,8 +1233,216 @@ namespace cabsl
     {
       _theInstance = nullptr;
       lastFrameTime = _currentFrameTime;
+      frameSignature = signature;
       assert(depth == 0);
+#ifdef CABSL_INSTRUMENTATION
+      if(allocationTracker)
+        allocationTracker->endFrame(); // stopped first, so only the behavior is tracked
+#endif
+      if(activationSink)
+        activationSink->endFrame();
+#ifdef CABSL_INSTRUMENTATION
+      if(traceBuffer)
+        traceBuffer->endFrame();
+      if(profiler)
+        profiler->endFrame();
+      if(latencyHistograms)
+        latencyHistograms->recordFrame(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - frameStart).count()));
+#endif
+    }
+
+    /**
+     * Returns the signature of the last frame. It is computed while the options are
+     * executed from their identifiers, the identifiers of their current states, their
+     * depths in the call hierarchy, and optionally the values of their arguments. It
+     * does not depend on how long options and states are already active. Frames in
+     * which the same options were active in the same states have the same signature.
+     * @return The signature. Only valid after `endFrame`.
+     */
+    std::uint64_t getFrameSignature() const {return frameSignature;}
+
+    /**
+     * Sets whether the values of arguments are included in frame signatures.
+     * Arguments the bytes of which do not represent their values, e.g. strings, are
+     * never included.
+     * @param signArguments Include the values of arguments?
+     */
+    void setSignArguments(bool signArguments)
+    {
+      this->signArguments = signArguments;
+    }
+
+    /**
+     * Writes the contexts of all options that were executed in the last frame to a
+     * checkpoint. States are stored by their names and times relative to the last
+     * frame, so the checkpoint can be restored by a restarted process. Only
+     * variables of trivially copyable types are stored. Must be called between
+     * frames, i.e. after `endFrame`.
+     * @param data The checkpoint is written to this buffer, replacing its previous contents.
+     */
+    void saveCheckpoint(std::vector<char>& data) const
+    {
+      assert(!_theInstance);
+      data.assign(checkpointMagic, checkpointMagic + sizeof(checkpointMagic) - 1);
+      writeCheckpoint(data, std::uint32_t(0));
+      std::uint32_t count = 0;
+      if(OptionInfos::options)
+        for(const OptionDescriptor* descriptor : *OptionInfos::options)
+        {
+          const OptionContext& context = getContext(*descriptor);
+          const bool active = context.lastFrame == lastFrameTime;
+          const bool selected = context.lastSelectFrame == lastFrameTime;
+          if(!active && !selected)
+            continue;
+          const StateDescriptor* state = context.state ? OptionInfos::findState(descriptor->name, context.state) : nullptr;
+          std::vector<char> vars;
+          if(context.vars)
+            context.vars.save(vars);
+          writeCheckpoint(data, descriptor->name);
+          writeCheckpoint(data, static_cast<std::uint8_t>((active ? 1 : 0) | (selected ? 2 : 0)));
+          writeCheckpoint(data, static_cast<std::uint8_t>(context.stateType));
+          writeCheckpoint(data, static_cast<std::uint8_t>(context.subOptionStateType));
+          writeCheckpoint(data, state ? state->name : "");
+          writeCheckpoint(data, static_cast<std::uint32_t>(lastFrameTime - context.optionStart));
+          writeCheckpoint(data, static_cast<std::uint32_t>(lastFrameTime - context.stateStart));
+          writeCheckpoint(data, static_cast<std::uint32_t>(vars.size()));
+          data.insert(data.end(), vars.begin(), vars.end());
+          ++count;
+        }
+      std::memcpy(data.data() + sizeof(checkpointMagic) - 1, &count, sizeof(count));
+    }
+
+    /**
+     * Restores the contexts of all options from a checkpoint written by
+     * `saveCheckpoint`, possibly by another process. The next frame continues
+     * the frame in which the checkpoint was written. All other options are
+     * reset. Options and states that no longer exist are skipped. In the
+     * latter case, the option restarts in its initial state. Must be called
+     * between frames.
+     * @param data The checkpoint.
+     * @param size The size of the checkpoint in bytes.
+     * @param frameTime The time of the frame in which the checkpoint was written,
+     *                  measured by the clock that is now passed to `beginFrame`.
+     * @return Was the checkpoint valid? If not, the contexts may have been
+     *         restored partially.
+     */
+    bool restoreCheckpoint(const char* data, size_t size, unsigned frameTime)
+    {
+      assert(!_theInstance);
+      const char* const end = data + size;
+      std::uint32_t count;
+      if(size < sizeof(checkpointMagic) - 1 || std::memcmp(data, checkpointMagic, sizeof(checkpointMagic) - 1))
+        return false;
+      data += sizeof(checkpointMagic) - 1;
+      if(!readCheckpoint(data, end, count))
+        return false;
+
+      lastFrameTime = _currentFrameTime = frameTime;
+      if(OptionInfos::options)
+        for(const OptionDescriptor* descriptor : *OptionInfos::options)
+        {
+          OptionContext& context = getContext(*descriptor);
+          context.lastFrame = context.lastSelectFrame = static_cast<unsigned>(-1);
+          context.restoredVars.clear();
+        }
+
+      while(count--)
+      {
+        std::string name, stateName;
+        std::uint8_t flags, stateType, subOptionStateType;
+        std::uint32_t optionAge, stateAge, varsSize;
+        if(!readCheckpoint(data, end, name) || !readCheckpoint(data, end, flags)
+           || !readCheckpoint(data, end, stateType) || !readCheckpoint(data, end, subOptionStateType)
+           || !readCheckpoint(data, end, stateName) || !readCheckpoint(data, end, optionAge)
+           || !readCheckpoint(data, end, stateAge) || !readCheckpoint(data, end, varsSize)
+           || varsSize > static_cast<size_t>(end - data) || stateType > OptionContext::abortedState
+           || subOptionStateType > OptionContext::abortedState)
+          return false;
+        const char* vars = data;
+        data += varsSize;
+
+        const OptionDescriptor* descriptor = OptionInfos::findOption(name.c_str());
+        if(!descriptor)
+          continue;
+        OptionContext& context = getContext(*descriptor);
+        const StateDescriptor* state = stateName.empty() ? nullptr : OptionInfos::findState(descriptor->name, stateName.c_str());
+        if(!stateName.empty() && (!state || state->stateType == OptionContext::initialState))
+          continue; // The state was removed, so the option restarts.
+        context.state = state ? state->id : 0;
+        context.stateName = state ? state->name : nullptr;
+        context.stateType = static_cast<typename OptionContext::StateType>(stateType);
+        context.subOptionStateType = static_cast<typename OptionContext::StateType>(subOptionStateType);
+        context.optionStart = frameTime - optionAge;
+        context.stateStart = frameTime - stateAge;
+        if(flags & 1)
+          context.lastFrame = frameTime;
+        if(flags & 2)
+          context.lastSelectFrame = frameTime;
+        if(context.vars)
+          context.vars.restore(vars, varsSize);
+        else
+          context.restoredVars.assign(vars, vars + varsSize);
+      }
+      return data == end;
+    }
+
+#ifdef CABSL_INSTRUMENTATION
+    /**
+     * Sets the buffer the execution of options is traced to.
+     * @param traceBuffer The buffer. Tracing is switched off if it is zero.
+     */
+    void setTraceBuffer(Tracer::Buffer* traceBuffer)
+    {
+      this->traceBuffer = traceBuffer;
+    }
+
+    /**
+     * Sets the profiler that aggregates statistics about the execution of options.
+     * @param profiler The profiler. Profiling is switched off if it is zero.
+     */
+    void setProfiler(Profiler* profiler)
+    {
+      this->profiler = profiler;
+    }
+
+    /**
+     * Sets the hardware performance counters that are measured per option.
+     * They must have been created in the thread that executes the behavior.
+     * @param perfCounters The counters. Measuring is switched off if it is zero.
+     */
+    void setPerfCounters(PerfCounters* perfCounters)
+    {
+      this->perfCounters = perfCounters;
+    }
+
+    /**
+     * Sets the tracker that attributes heap allocations during frames to options.
+     * This requires that `CABSL_TRACK_ALLOCATIONS` is defined in one compilation unit.
+     * @param allocationTracker The tracker. Tracking is switched off if it is zero.
+     */
+    void setAllocationTracker(AllocationTracker* allocationTracker)
+    {
+      this->allocationTracker = allocationTracker;
+    }
+
+    /**
+     * Sets the histograms the durations of frames and root options are recorded in.
+     * @param latencyHistograms The histograms. Recording is switched off if it is zero.
+     */
+    void setLatencyHistograms(LatencyHistograms* latencyHistograms)
+    {
+      this->latencyHistograms = latencyHistograms;
+    }
+
+    /**
+     * Sets the statistics that count the state transitions and option calls executed.
+     * @param edgeStatistics The statistics. Counting is switched off if it is zero.
+     */
+    void setEdgeStatistics(EdgeStatistics* edgeStatistics)
+    {
+      this->edgeStatistics = edgeStatistics;
     }
+#endif
   };
 
   template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
@@ -526,7 +1450,15 @@ namespace cabsl
   template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
     std::unordered_map<std::string, const typename Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionDescriptor*>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::optionsByName;
   template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
-    std::vector<void (*)()>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::initHandlers;
+    std::vector<const typename Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionDescriptor*>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::options;
+  template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
+    std::vector<void (*)(CabslBehavior*)>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::initHandlers;
+  template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
+    std::vector<const typename Cabsl<CabslBehavior, InFileStream, OutStringStream>::StateDescriptor*>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::states;
+  template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
+    std::unordered_map<std::string, std::vector<const typename Cabsl<CabslBehavior, InFileStream, OutStringStream>::StateDescriptor*>>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::stateTables;
+  template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
+    std::unordered_map<std::string, std::atomic<const typename Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionImplementation*>>* Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos::implementations;
   template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
     typename Cabsl<CabslBehavior, InFileStream, OutStringStream>::OptionInfos Cabsl<CabslBehavior, InFileStream, OutStringStream>::collectOptions;
   template<typename CabslBehavior, typename InFileStream, typename OutStringStream>
@@ -539,27 +1471,102 @@ namespace cabsl
    * decltype(TypeWrapper<myType>::type) myVar;
    */
   template<typename T> struct TypeWrapper {static T type;};
+
+  /**
+   * Is an argument of type T passed to the option body by value? Only small,
+   * trivially copyable types are. All others are passed by const reference, so
+   * they are never copied between the call site and the option body. Arguments
+   * declared as references are passed as declared.
+   */
+  template<typename T> inline constexpr bool isPassedByValue = std::is_reference<T>::value
+    || (std::is_trivially_copyable<T>::value && sizeof(T) <= 2 * sizeof(void*));
+
+  /** The type of the parameter through which an argument of type T is passed to the option body. */
+  template<typename T> using ArgParam = typename std::conditional<isPassedByValue<T>, T, const typename std::remove_reference<T>::type&>::type;
+
+  /**
+   * An argument with a default value that is passed by reference. An actual
+   * argument is only referenced. The default value or a temporary object
+   * passed is moved into this object. It is only used as a member of the
+   * structure of arguments, which lives until the option call returns.
+   * @tparam T The type of the argument.
+   */
+  template<typename T> class ArgRef
+  {
+    std::optional<T> owned; /**< The default value or the temporary object passed. */
+    const T* pointer; /**< The argument. */
+
+  public:
+    ArgRef(const T& value) : pointer(&value) {}
+    ArgRef(T&& value) : owned(std::move(value)), pointer(&*owned) {}
+
+    /** Constructs the argument from other values, e.g. a default value of another type or a braced list. */
+    template<typename... U, typename = typename std::enable_if<!(sizeof...(U) == 1 && (std::is_same<typename std::decay<U>::type, T>::value && ...))>::type>
+    ArgRef(U&&... values) : owned(T{std::forward<U>(values)...}), pointer(&*owned) {}
+
+    ArgRef(const ArgRef&) = delete;
+    ArgRef& operator=(const ArgRef&) = delete;
+
+    /**
+     * Returns the argument.
+     * @return A reference to the actual argument or the default value.
+     */
+    const T& get() const {return *pointer;}
+  };
+
+  /**
+   * The type an argument of type T is stored as in the structure of arguments
+   * if it has a default value.
+   */
+  template<typename T> using ArgField = typename std::conditional<isPassedByValue<T>,
+                                                                  typename std::remove_const<typename std::remove_reference<T>::type>::type,
+                                                                  ArgRef<typename std::remove_cv<typename std::remove_reference<T>::type>::type>>::type;
+
+  /**
+   * Returns the value of an argument stored in the structure of arguments.
+   * @param value The member of the structure.
+   * @return The value of the argument.
+   */
+  template<typename T> const T& argValue(const T& value) {return value;}
+  template<typename T> const T& argValue(const ArgRef<T>& value) {return value.get();}
 }
 
+#ifdef CABSL_MODULE
+/**
+ * The function through which the program loading a module accesses it.
+ * @return The options and states implemented by this module.
+ */
+extern "C" __attribute__((visibility("default"), used)) inline const cabsl::ModuleInfo* cabslModule()
+{
+  return &cabsl::moduleInfo;
+}
+#endif
+
 /**
  * The macro defines a state. It must be followed by a block of code that defines the state's body.
  * @param name The name of the state.
  */
-#define state(name) _state(name, __LINE__, OptionContext::normalState)
+#define state(name) _state(name, _CABSL_STATE_ID(name), OptionContext::normalState)
 
 /**
  * The macro defines a target state. It must be followed by a block of code that defines the state's body.
  * A parent option can check whether a target state has been reached through `action_done`.
  * @param name The name of the target state.
  */
-#define target_state(name) _state(name, __LINE__, OptionContext::targetState)
+#define target_state(name) _state(name, _CABSL_STATE_ID(name), OptionContext::targetState)
 
 /**
  * The macro defines an aborted state. It must be followed by a block of code that defines the state's body.
  * A parent option can check whether an aborted state has been reached through `action_aborted`.
  * @param name The name of the aborted state.
  */
-#define aborted_state(name) _state(name, __LINE__, OptionContext::abortedState)
+#define aborted_state(name) _state(name, _CABSL_STATE_ID(name), OptionContext::abortedState)
+
+/**
+ * The identifier of a state as a compile time constant.
+ * @param name The name of the state.
+ */
+#define _CABSL_STATE_ID(name) std::integral_constant<int, cabsl::stateId(__func__, #name)>::value
 
 /**
  * The macro defines an option. It must be followed by a block of code that defines the option's body.
@@ -569,129 +1576,152 @@ namespace cabsl
  * @param ... The name of the option and an arbitrary number of arguments. They can include default
  *            arguments at the end. Their syntax is described at the beginning of this file.
  */
-#define option(...) _CABSL_OPTION(_CABSL_TUPLE_SIZE(__VA_ARGS__), __VA_ARGS__)
-
-// Determine whether a class, arguments, definitions, and/or variables were specified.
-// Then _CABSL_OPTION_II is called with all this information.
-#define _CABSL_OPTION(n, ...) _CABSL_JOIN(_CABSL_OPTION_, n) (__VA_ARGS__)
-#define _CABSL_OPTION_1(name) _CABSL_OPTION_I(name, , , , , ignore)
-#define _CABSL_OPTION_2(name, ...) _CABSL_OPTION_I(name, _CABSL_HAS_ARGS(__VA_ARGS__), _CABSL_HAS_DEFS(__VA_ARGS__), _CABSL_HAS_LOAD(__VA_ARGS__), _CABSL_HAS_VARS(__VA_ARGS__), __VA_ARGS__)
-#define _CABSL_OPTION_3(...) _CABSL_OPTION_2(__VA_ARGS__)
-#define _CABSL_OPTION_4(...) _CABSL_OPTION_2(__VA_ARGS__)
-#define _CABSL_OPTION_I(name, hasArgs, hasDefs, hasLoad, hasVars, ...) _CABSL_JOIN(_CABSL_OPTION_I_, _CABSL_SEQ_SIZE(name))(name, hasArgs, hasDefs, hasLoad, hasVars, __VA_ARGS__)
-#define _CABSL_OPTION_I_0(name, hasArgs, hasDefs, hasLoad, hasVars, ...) _CABSL_OPTION_II(name, , , hasArgs, hasDefs, hasLoad, hasVars, __VA_ARGS__)
-#define _CABSL_OPTION_I_1(name, hasArgs, hasDefs, hasLoad, hasVars, ...) _CABSL_OPTION_II(_CABSL_VAR(name), _CABSL_OPTION_I_1_I(name), 1, hasArgs, hasDefs, hasLoad, hasVars, __VA_ARGS__)
+#define option(...) _CABSL_OPTION(__VA_ARGS__, , , )
+
+// Determine whether a class, arguments, definitions, and/or variables were specified
+// and extract the lists of arguments, definitions, and variables. Since there are at
+// most three parameters after the name, they are padded to exactly three, which avoids
+// counting them. Then _CABSL_OPTION_II is called with all this information. The lists
+// are passed in parentheses, so each of them is a single macro parameter.
+#define _CABSL_OPTION(name, p1, p2, p3, ...) \
+  _CABSL_OPTION_I(name, \
+                  _CABSL_PARAMS(HAS_ARGS, p1, p2, p3), \
+                  _CABSL_PARAMS(HAS_DEFS, p1, p2, p3), \
+                  _CABSL_PARAMS(HAS_LOAD, p1, p2, p3), \
+                  _CABSL_PARAMS(HAS_VARS, p1, p2, p3), \
+                  (_CABSL_PARAMS(GET_ARGS, p1, p2, p3)), \
+                  (_CABSL_PARAMS(GET_DEFS, p1, p2, p3)), \
+                  (_CABSL_PARAMS(GET_VARS, p1, p2, p3)))
+#define _CABSL_OPTION_I(name, hasArgs, hasDefs, hasLoad, hasVars, args, defs, vars) _CABSL_JOIN(_CABSL_OPTION_I_, _CABSL_SEQ_SIZE(name))(name, hasArgs, hasDefs, hasLoad, hasVars, args, defs, vars)
+#define _CABSL_OPTION_I_0(name, hasArgs, hasDefs, hasLoad, hasVars, args, defs, vars) _CABSL_OPTION_II(name, , , hasArgs, hasDefs, hasLoad, hasVars, args, defs, vars)
+#define _CABSL_OPTION_I_1(name, hasArgs, hasDefs, hasLoad, hasVars, args, defs, vars) _CABSL_OPTION_II(_CABSL_VAR(name), _CABSL_OPTION_I_1_I(name), 1, hasArgs, hasDefs, hasLoad, hasVars, args, defs, vars)
 #define _CABSL_OPTION_I_1_I(name) _CABSL_DECL_I name))
 
 // Generate the actual code for the option header. The `has` parameters are either
-// `1` or empty.
-#define _CABSL_OPTION_II(name, class, hasClass, hasArgs, hasDefs, hasLoad, hasVars, ...) \
+// `1` or empty. `args`, `defs`, and `vars` are parenthesized lists.
+#define _CABSL_OPTION_II(name, class, hasClass, hasArgs, hasDefs, hasLoad, hasVars, args, defs, vars) \
   _CABSL_DECL_CONTEXT_##hasClass##_##hasArgs(name) \
-  _CABSL_STRUCT_ARGS_##hasClass##_##hasArgs(name, __VA_ARGS__) \
+  _CABSL_STRUCT_ARGS_##hasClass##_##hasArgs(name, args) \
   _CABSL_NAMESPACE_BEGIN_##hasClass(class) \
-  _CABSL_STRUCT_DEFS_##hasClass##_##hasDefs##_##hasLoad(name, class, __VA_ARGS__) \
-  _CABSL_STRUCT_VARS_##hasVars(name, __VA_ARGS__) \
+  _CABSL_STRUCT_DEFS_##hasClass##_##hasDefs##_##hasLoad(name, class, defs) \
+  _CABSL_STRUCT_VARS_##hasVars(name, vars) \
   _CABSL_NAMESPACE_END_##hasClass(class) \
   _CABSL_INIT_DEFS_##hasClass##_##hasDefs##_##hasLoad(name, class) \
-  _CABSL_FUNS_##hasClass##_##hasArgs##_##hasDefs##_##hasVars(name, class, __VA_ARGS__)
+  _CABSL_MODULE_##hasClass##_##hasArgs(name, class) \
+  _CABSL_FUNS_##hasClass##_##hasArgs##_##hasDefs##_##hasVars(name, class, args, defs, vars)
 
 // Declare the option context if executed in the header file (inline).
 // Also generate registration method for the option if it has no arguments.
 #define _CABSL_DECL_CONTEXT__(name) \
   static void _##name##DescriptorReg() \
   { \
-    static OptionDescriptor descriptor(#name, reinterpret_cast<void (CabslBehavior::*)(const OptionExecution&)>(&CabslBehavior::name), \
+    static OptionDescriptor descriptor(#name, static_cast<void (CabslBehavior::*)(const OptionExecution&)>(&CabslBehavior::name), \
                               reinterpret_cast<size_t>(&reinterpret_cast<CabslBehavior*>(16)->_##name##Context) - 16); \
     OptionInfos::add(descriptor); \
   } \
   OptionInfo<&CabslBehavior::_##name##DescriptorReg> _##name##Context;
 #define _CABSL_DECL_CONTEXT_1_(name, ...)
 #define _CABSL_DECL_CONTEXT__1(name, ...) \
-  OptionContext _##name##Context;
+  static void _##name##DescriptorReg() \
+  { \
+    static OptionDescriptor descriptor(#name, nullptr, \
+                              reinterpret_cast<size_t>(&reinterpret_cast<CabslBehavior*>(16)->_##name##Context) - 16); \
+    OptionInfos::add(descriptor); \
+  } \
+  OptionInfo<&CabslBehavior::_##name##DescriptorReg> _##name##Context;
 #define _CABSL_DECL_CONTEXT_1_1(name, ...)
 
 // Define a structure that contains arguments.
 // The structure is only defined if it is needed (second `1` of the name).
 // It is only defined if the first `1` is not present, because the structure
 // for arguments is only defined inline, never in the implementation file.
-#define _CABSL_STRUCT_ARGS__(name, ...)
-#define _CABSL_STRUCT_ARGS_1_(name, ...)
-#define _CABSL_STRUCT_ARGS__1(name, ...) _CABSL_STRUCT_ARGS_I(name, _CABSL_GET_ARGS(__VA_ARGS__), ignore)
-#define _CABSL_STRUCT_ARGS_I(name, ...) _CABSL_STRUCT_ARGS_II(name, _CABSL_TUPLE_SIZE(__VA_ARGS__), __VA_ARGS__)
-#define _CABSL_STRUCT_ARGS_II(name, n, ...) _CABSL_STRUCT_ARGS_III(name, n, (_CABSL_STRUCT_WITH_INIT, __VA_ARGS__))
-#define _CABSL_STRUCT_ARGS_III(name, n, pair) \
+#define _CABSL_STRUCT_ARGS__(name, list)
+#define _CABSL_STRUCT_ARGS_1_(name, list)
+#define _CABSL_STRUCT_ARGS__1(name, list) \
   struct _##name##Args \
   { \
-    _CABSL_ATTR_##n pair \
+    _CABSL_APPLY(_CABSL_STRUCT_ARG, list) \
   };
-#define _CABSL_STRUCT_ARGS_1_1(name, ...)
+#define _CABSL_STRUCT_ARGS_1_1(name, list)
+
+// Generate the declaration of an argument in the structure. Arguments without a default
+// value are referenced. Arguments with a default value are stored as `ArgField`, which
+// only references them as well unless they are small.
+#define _CABSL_STRUCT_ARG(seq) _CABSL_JOIN(_CABSL_STRUCT_ARG_, _CABSL_SEQ_SIZE(seq))(seq)
+#define _CABSL_STRUCT_ARG_1(seq) _CABSL_STRUCT_WITH_INIT(seq)
+#define _CABSL_STRUCT_ARG_2(seq) cabsl::ArgField<decltype(cabsl::TypeWrapper<_CABSL_DECL_I seq))>::type)> _CABSL_VAR(seq) _CABSL_INIT(seq);
 
 // Generate the declaration and optional initialization of a field in the structure.
 #define _CABSL_STRUCT_WITH_INIT(seq) std::remove_const<std::remove_reference<decltype(cabsl::TypeWrapper<_CABSL_DECL_I seq))>::type)>::type>::type _CABSL_CONST_REF(seq) _CABSL_VAR(seq) _CABSL_INIT(seq);
 
 // Define a structure for definitions. If `load` is used, the structure has a function `_read`.
-#define _CABSL_STRUCT_DEFS___(name, class, ...)
-#define _CABSL_STRUCT_DEFS_1__(name, class, ...)
-#define _CABSL_STRUCT_DEFS__1_(name, class, ...) \
-  struct _##name##Defs : public cabsl::StructBase \
+#define _CABSL_STRUCT_DEFS___(name, class, list)
+#define _CABSL_STRUCT_DEFS_1__(name, class, list)
+#define _CABSL_STRUCT_DEFS__1_(name, class, list) \
+  struct _##name##Defs \
   { \
-    _CABSL_STRUCT_DEFS_I(name, _CABSL_GET_DEFS(__VA_ARGS__), ignore) \
+    _CABSL_APPLY(_CABSL_STRUCT_WITH_INIT, list) \
   };
-#define _CABSL_STRUCT_DEFS_1_1_(name, class, ...) _CABSL_STRUCT_DEFS__1_(name, class, __VA_ARGS__)
-#define _CABSL_STRUCT_DEFS__1_1(name, class, ...) _CABSL_STRUCT_DEFS_IV(name, , __VA_ARGS__)
-#define _CABSL_STRUCT_DEFS_1_1_1(name, class, ...) _CABSL_STRUCT_DEFS_IV(name, class::, __VA_ARGS__)
-#define _CABSL_STRUCT_DEFS_IV(name, prefix, ...) \
-  struct _##name##Defs : public cabsl::StructBase \
+#define _CABSL_STRUCT_DEFS_1_1_(name, class, list) _CABSL_STRUCT_DEFS__1_(name, class, list)
+#define _CABSL_STRUCT_DEFS__1_1(name, class, list) _CABSL_STRUCT_DEFS_I(name, , list)
+#define _CABSL_STRUCT_DEFS_1_1_1(name, class, list) _CABSL_STRUCT_DEFS_I(name, class::, list)
+#define _CABSL_STRUCT_DEFS_I(name, prefix, list) \
+  struct _##name##Defs \
   { \
-    _CABSL_STRUCT_DEFS_I(name, _CABSL_GET_DEFS(__VA_ARGS__), ignore) \
+    _CABSL_APPLY(_CABSL_STRUCT_WITH_INIT, list) \
     void _read(prefix InFileStream& _stream) \
     { \
-      _CABSL_READ_DEFS_I(name, _CABSL_GET_DEFS(__VA_ARGS__), ignore) \
+      _CABSL_APPLY(_CABSL_READ_DEF, list) \
     } \
   };
-#define _CABSL_STRUCT_DEFS_I(name, ...) _CABSL_STRUCT_DEFS_II(name, _CABSL_TUPLE_SIZE(__VA_ARGS__), __VA_ARGS__)
-#define _CABSL_STRUCT_DEFS_II(name, n, ...) _CABSL_STRUCT_DEFS_III(name, n, (_CABSL_STRUCT_WITH_INIT, __VA_ARGS__))
-#define _CABSL_STRUCT_DEFS_III(name, n, pair) _CABSL_ATTR_##n pair
-#define _CABSL_READ_DEFS_I(name, ...) _CABSL_READ_DEFS_II(name, _CABSL_TUPLE_SIZE(__VA_ARGS__), __VA_ARGS__)
-#define _CABSL_READ_DEFS_II(name, n, ...) _CABSL_READ_DEFS_III(name, n, (_CABSL_READ_DEF, __VA_ARGS__))
-#define _CABSL_READ_DEFS_III(name, n, pair) _CABSL_ATTR_##n pair
 
 // Generate the declaration and optional initialization of a field in the structure.
 #define _CABSL_READ_DEF(seq) _stream.read(#seq, _CABSL_VAR(seq));
 
 // Define a structure that contains variables.
 // The structure is only defined if it is needed (addition `1` of the name).
-#define _CABSL_STRUCT_VARS_(name, ...)
-#define _CABSL_STRUCT_VARS_1(name, ...) _CABSL_STRUCT_VARS_I(name, _CABSL_GET_VARS(__VA_ARGS__), ignore)
-#define _CABSL_STRUCT_VARS_I(name, ...) _CABSL_STRUCT_VARS_II(name, _CABSL_TUPLE_SIZE(__VA_ARGS__), __VA_ARGS__)
-#define _CABSL_STRUCT_VARS_II(name, n, ...) _CABSL_STRUCT_VARS_III(name, n, (_CABSL_STRUCT_WITHOUT_INIT, __VA_ARGS__))
-#define _CABSL_STRUCT_VARS_III(name, n, pair) \
-  struct _##name##Vars : public cabsl::StructBase \
+#define _CABSL_STRUCT_VARS_(name, list)
+#define _CABSL_STRUCT_VARS_1(name, list) \
+  struct _##name##Vars \
   { \
-    _CABSL_ATTR_##n pair \
+    _CABSL_APPLY(_CABSL_STRUCT_WITHOUT_INIT, list) \
+    void _save(std::vector<char>& _data) const \
+    { \
+      _CABSL_APPLY(_CABSL_SAVE_VAR, list) \
+    } \
+    void _restore(const char* _data, size_t _size) \
+    { \
+      _CABSL_APPLY(_CABSL_RESTORE_VAR, list) \
+    } \
   };
 
 // Generate the declaration of a field in the structure.
 #define _CABSL_STRUCT_WITHOUT_INIT(seq) std::remove_const<std::remove_reference<decltype(cabsl::TypeWrapper<_CABSL_DECL_I seq))>::type)>::type>::type _CABSL_VAR(seq);
 
+// Save and restore a field of the structure for checkpoints.
+#define _CABSL_SAVE_VAR(seq) cabsl::saveMember(_data, _CABSL_NAME(seq), _CABSL_VAR(seq));
+#define _CABSL_RESTORE_VAR(seq) cabsl::restoreMember(_data, _size, _CABSL_NAME(seq), _CABSL_VAR(seq));
+
 // Define an initialization handler and a function that registers it.
 // It is distinguished whether a class was specified (implementation file) or not (header),
 // whether there actually are definitions, and whether they are read from a file.
 #define _CABSL_INIT_DEFS___(name, class) \
-  static void _##name##Init(); \
+  static void _##name##Init(CabslBehavior* _instance); \
   static void _##name##InitReg();
 #define _CABSL_INIT_DEFS_1__(name, class)
-#define _CABSL_INIT_DEFS__1_(name, class) _CABSL_INIT_DEFS_I(name, , static, )
-#define _CABSL_INIT_DEFS__1_1(name, class) _CABSL_INIT_DEFS_I(name, , static, InFileStream _stream(#name); _defs->_read(_stream);)
-#define _CABSL_INIT_DEFS_1_1_(name, class) _CABSL_INIT_DEFS_I(name, class::, , )
-#define _CABSL_INIT_DEFS_1_1_1(name, class) _CABSL_INIT_DEFS_I(name, class::, , InFileStream _stream(#name); _defs->_read(_stream);)
-#define _CABSL_INIT_DEFS_I(name, class, prefix, load) \
-  prefix void class _##name##Init() \
+// An option implemented separately does not initialize its definitions while a module
+// replaces it, because the module creates its own ones.
+#define _CABSL_INIT_DEFS__1_(name, class) _CABSL_INIT_DEFS_I(name, , static, , )
+#define _CABSL_INIT_DEFS__1_1(name, class) _CABSL_INIT_DEFS_I(name, , static, InFileStream _stream(#name); _defs->_read(_stream);, )
+#define _CABSL_INIT_DEFS_1_1_(name, class) _CABSL_INIT_DEFS_I(name, class::, , , _CABSL_NOT_REPLACED(name))
+#define _CABSL_INIT_DEFS_1_1_1(name, class) _CABSL_INIT_DEFS_I(name, class::, , InFileStream _stream(#name); _defs->_read(_stream);, _CABSL_NOT_REPLACED(name))
+#define _CABSL_INIT_DEFS_I(name, class, prefix, load, condition) \
+  prefix void class _##name##Init(CabslBehavior* _instance) \
   { \
-    _##name##Defs*& _defs = reinterpret_cast<_##name##Defs*&>(static_cast<CabslBehavior*>(_theInstance)->_##name##Context.defs); \
-    if(!_defs) \
+    cabsl::StructStorage& _storage = _instance->_##name##Context.defs; \
+    if(!_storage condition) \
     { \
-      _defs = new _##name##Defs(); \
+      [[maybe_unused]] _##name##Defs* _defs = _storage.template create<_##name##Defs>(); \
       load \
     } \
   } \
@@ -700,6 +1730,53 @@ namespace cabsl
     OptionInfos::add(&CabslBehavior::_##name##Init); \
   }
 
+#ifdef CABSL_MODULE
+#define _CABSL_NOT_REPLACED(name)
+#else
+#define _CABSL_NOT_REPLACED(name) && !OptionInfos::implementation(#name).load(std::memory_order_acquire)
+#endif
+
+// Register the implementation of an option in a module. A class derived from the behavior
+// is used to access the members of the behavior. Nothing is generated for the program itself.
+#define _CABSL_MODULE__(name, class)
+#define _CABSL_MODULE__1(name, class)
+#ifdef CABSL_MODULE
+#define _CABSL_MODULE_1_(name, class) _CABSL_MODULE_I(name, class, name, void (CabslBehavior::*)(const OptionExecution&))
+#define _CABSL_MODULE_1_1(name, class) _CABSL_MODULE_I(name, class, _##name, decltype(&CabslBehavior::_##name))
+#define _CABSL_MODULE_I(name, class, entry, type) \
+  namespace \
+  { \
+    struct _##name##Module : public class \
+    { \
+      static const OptionImplementation* implementation() \
+      { \
+        static const OptionImplementation implementation{#name, reinterpret_cast<void (CabslBehavior::*)()>(static_cast<type>(&_##name##Module::entry)), \
+                                                         reinterpret_cast<size_t>(&reinterpret_cast<_##name##Module*>(16)->_##name##Context) - 16}; \
+        return &implementation; \
+      } \
+      static inline const bool registered = (cabsl::moduleInfo.options.push_back(implementation()), cabsl::moduleInfo.connect = &OptionInfos::connect, true); \
+    }; \
+  }
+#else
+#define _CABSL_MODULE_1_(name, class)
+#define _CABSL_MODULE_1_1(name, class)
+#endif
+
+// Code executed when the implementation of an option in a separate file is entered.
+// In the program, the call is forwarded to the implementation of a module if one
+// replaces it. `type` is the type of the method that implements the option.
+#ifdef CABSL_MODULE
+#define _CABSL_ENTRY(name, type, ...)
+#else
+#define _CABSL_ENTRY(name, type, ...) \
+  static const std::atomic<const OptionImplementation*>& _implementation = OptionInfos::implementation(#name); \
+  if(const OptionImplementation* _replacement = _implementation.load(std::memory_order_acquire)) \
+  { \
+    (this->*reinterpret_cast<type>(_replacement->function))(__VA_ARGS__); \
+    return; \
+  }
+#endif
+
 // Generate start of namespace if used in implementation file.
 #define _CABSL_NAMESPACE_BEGIN_(class)
 #define _CABSL_NAMESPACE_BEGIN_1(class) namespace _ns##class {
@@ -716,234 +1793,290 @@ namespace cabsl
 // - Variables defined or not
 
 // Inline, no `args`, no `defs`, no `vars`
-#define _CABSL_FUNS____(name, class, ...) \
+#define _CABSL_FUNS____(name, class, args, defs, vars) \
   _CABSL_NOARGS_HEAD(name)
 
 // Not inline, no `args`, no `defs`, no `vars`
-// Option is called directly. Default argument was declared in header.
-#define _CABSL_FUNS_1___(name, class, ...) \
-  void class::name(const OptionExecution& _o)
+// Default argument was declared in header. Wrapper class needed to define another method.
+#define _CABSL_FUNS_1___(name, class, args, defs, vars) \
+  namespace _ns##class \
+  { \
+    struct name##Wrapper : public class \
+    { \
+      void name(const OptionExecution& _o); \
+    }; \
+  } \
+  void class::name(const OptionExecution& _o) \
+  { \
+    _CABSL_ENTRY(name, void (CabslBehavior::*)(const OptionExecution&), _o) \
+    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_o); \
+  } \
+  void _ns##class::name##Wrapper::name(const OptionExecution& _o)
 
 // Inline, `args`, no `defs`, no `vars`
 // Helper needed to stream and translate arguments.
-#define _CABSL_FUNS__1__(name, class, ...) \
-  _CABSL_ARGS_HEAD(name, __VA_ARGS__) \
-    _##name(_CABSL_APPLY(_CABSL_PASS_ARG, _CABSL_GET_ARGS(__VA_ARGS__)) _o); \
+#define _CABSL_FUNS__1__(name, class, args, defs, vars) \
+  _CABSL_ARGS_HEAD(name, args) \
+    _##name(_CABSL_APPLY(_CABSL_PASS_ARG, args) _o); \
   } \
-  void _##name(_CABSL_APPLY(_CABSL_DECL_ARG, _CABSL_GET_ARGS(__VA_ARGS__)) const OptionExecution& _o)
+  void _##name(_CABSL_APPLY(_CABSL_DECL_ARG, args) const OptionExecution& _o)
 
 // Not inline, `args`, no `defs`, no `vars`
 // Helper was declared in header that calls actual option.
 // There should be no defaults for arguments. Generate them if they are, so the compiler will complain.
-#define _CABSL_FUNS_1_1__(name, class, ...) \
-  void class::_##name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) const OptionExecution& _o)
+// Wrapper class needed to define another method.
+#define _CABSL_FUNS_1_1__(name, class, args, defs, vars) \
+  namespace _ns##class \
+  { \
+    struct name##Wrapper : public class \
+    { \
+      void name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) const OptionExecution& _o); \
+    }; \
+  } \
+  void class::_##name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) const OptionExecution& _o) \
+  { \
+    _CABSL_ENTRY(name, decltype(&CabslBehavior::_##name), _CABSL_APPLY(_CABSL_PASS_PARAM, args) _o) \
+    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_PARAM, args) _o); \
+  } \
+  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) const OptionExecution& _o)
 
 // Inline, no `args`, `defs`, no `vars`
 // Helper needed to handle `defs`.
-#define _CABSL_FUNS___1_(name, class, ...) \
+#define _CABSL_FUNS___1_(name, class, args, defs, vars) \
   _CABSL_NOARGS_HEAD(name) \
   { \
     _CABSL_DEFS_IMPL(name) \
-    _##name(_CABSL_APPLY(_CABSL_PASS_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _o); \
+    _##name(_CABSL_APPLY(_CABSL_PASS_DEF, defs) _o); \
   } \
-  void _##name(_CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) const OptionExecution& _o)
+  void _##name(_CABSL_APPLY(_CABSL_DECL_DEF, defs) const OptionExecution& _o)
 
 // Not inline, no `args`, `defs`, no `vars`
 // Helper needed to handle `defs`. Wrapper class needed to define another method.
-#define _CABSL_FUNS_1__1_(name, class, ...) \
+#define _CABSL_FUNS_1__1_(name, class, args, defs, vars) \
   namespace _ns##class \
   { \
     struct name##Wrapper : public class \
     { \
-      void name(_CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) const OptionExecution& _o); \
+      void name(_CABSL_APPLY(_CABSL_DECL_DEF, defs) const OptionExecution& _o); \
     }; \
   } \
   void class::name(const OptionExecution& _o) \
   { \
+    _CABSL_ENTRY(name, void (CabslBehavior::*)(const OptionExecution&), _o) \
     _CABSL_DEFS_IMPL(name) \
-    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _o); \
+    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_DEF, defs) _o); \
   } \
-  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) const OptionExecution& _o)
+  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_DEF, defs) const OptionExecution& _o)
 
 // Inline, `args`, `defs`, no `vars`
 // Helper needed to stream and translate arguments and handle `defs`.
-#define _CABSL_FUNS__1_1_(name, class, ...) \
-  _CABSL_ARGS_HEAD(name, __VA_ARGS__) \
+#define _CABSL_FUNS__1_1_(name, class, args, defs, vars) \
+  _CABSL_ARGS_HEAD(name, args) \
     _CABSL_DEFS_IMPL(name) \
-    _##name(_CABSL_APPLY(_CABSL_PASS_ARG, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _o); \
+    _##name(_CABSL_APPLY(_CABSL_PASS_ARG, args) _CABSL_APPLY(_CABSL_PASS_DEF, defs) _o); \
   } \
-  void _##name(_CABSL_APPLY(_CABSL_DECL_ARG, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) const OptionExecution& _o)
+  void _##name(_CABSL_APPLY(_CABSL_DECL_ARG, args) _CABSL_APPLY(_CABSL_DECL_DEF, defs) const OptionExecution& _o)
 
 // Not inline, `args`, `defs`, no `vars`
 // Header already handled `args`. Second helper needed to handle `defs`.
 // Wrapper class needed to define a third method.
-#define _CABSL_FUNS_1_1_1_(name, class, ...) \
+#define _CABSL_FUNS_1_1_1_(name, class, args, defs, vars) \
   namespace _ns##class \
   { \
     struct name##Wrapper : public class \
     { \
-      void name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) const OptionExecution& _o); \
+      void name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) _CABSL_APPLY(_CABSL_DECL_DEF, defs) const OptionExecution& _o); \
     }; \
   } \
-  void class::_##name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) const OptionExecution& _o) \
+  void class::_##name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) const OptionExecution& _o) \
   { \
+    _CABSL_ENTRY(name, decltype(&CabslBehavior::_##name), _CABSL_APPLY(_CABSL_PASS_PARAM, args) _o) \
     _CABSL_DEFS_IMPL(name) \
-    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_PARAM, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _o); \
+    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_PARAM, args) _CABSL_APPLY(_CABSL_PASS_DEF, defs) _o); \
   } \
-  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) const OptionExecution& _o)
+  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) _CABSL_APPLY(_CABSL_DECL_DEF, defs) const OptionExecution& _o)
 
 // Inline, no `args`, no `defs`, `vars`
 // Helper needed to handle `vars`.
-#define _CABSL_FUNS____1(name, class, ...) \
+#define _CABSL_FUNS____1(name, class, args, defs, vars) \
   _CABSL_NOARGS_HEAD(name) \
   { \
-    _CABSL_VARS_IMPL(name, __VA_ARGS__) \
-    _##name(_CABSL_APPLY(_CABSL_PASS_VAR, _CABSL_GET_VARS(__VA_ARGS__)) _o); \
+    _CABSL_VARS_IMPL(name, vars) \
+    _##name(_CABSL_APPLY(_CABSL_PASS_VAR, vars) _o); \
   } \
-  void _##name(_CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o)
+  void _##name(_CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o)
 
 // Not inline, no `args`, no `defs`, `vars`
 // Helper needed to handle vars. Wrapper class needed to define another method.
-#define _CABSL_FUNS_1___1(name, class, ...) \
+#define _CABSL_FUNS_1___1(name, class, args, defs, vars) \
   namespace _ns##class \
   { \
     struct name##Wrapper : public class \
     { \
-      void name(_CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o); \
+      void name(_CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o); \
     }; \
   } \
   void class::name(const OptionExecution& _o) \
   { \
-    _CABSL_VARS_IMPL(name, __VA_ARGS__) \
-    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_VAR, _CABSL_GET_VARS(__VA_ARGS__)) _o); \
+    _CABSL_ENTRY(name, void (CabslBehavior::*)(const OptionExecution&), _o) \
+    _CABSL_VARS_IMPL(name, vars) \
+    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_VAR, vars) _o); \
   } \
-  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o)
+  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o)
 
 // Inline, `args`, no `defs`, `vars`
 // Helper needed to stream and translate arguments and handle `vars`.
-#define _CABSL_FUNS__1__1(name, class, ...) \
-  _CABSL_ARGS_HEAD(name, __VA_ARGS__) \
-    _CABSL_VARS_IMPL(name, __VA_ARGS__) \
-    _##name(_CABSL_APPLY(_CABSL_PASS_ARG, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_VAR, _CABSL_GET_VARS(__VA_ARGS__)) _o); \
+#define _CABSL_FUNS__1__1(name, class, args, defs, vars) \
+  _CABSL_ARGS_HEAD(name, args) \
+    _CABSL_VARS_IMPL(name, vars) \
+    _##name(_CABSL_APPLY(_CABSL_PASS_ARG, args) _CABSL_APPLY(_CABSL_PASS_VAR, vars) _o); \
   } \
-  void _##name(_CABSL_APPLY(_CABSL_DECL_ARG, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o)
+  void _##name(_CABSL_APPLY(_CABSL_DECL_ARG, args) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o)
 
 // Not inline, `args`, no `defs`, `vars`
 // Header already handled `args`. Second helper needed to handle `vars`.
 // Wrapper class needed to define a third method.
-#define _CABSL_FUNS_1_1__1(name, class, ...) \
+#define _CABSL_FUNS_1_1__1(name, class, args, defs, vars) \
   namespace _ns##class \
   { \
     struct name##Wrapper : public class \
     { \
-      void name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o); \
+      void name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o); \
     }; \
   } \
-  void class::_##name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) const OptionExecution& _o) \
+  void class::_##name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) const OptionExecution& _o) \
   { \
-    _CABSL_VARS_IMPL(name, __VA_ARGS__) \
-    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_PARAM, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_VAR, _CABSL_GET_VARS(__VA_ARGS__)) _o); \
+    _CABSL_ENTRY(name, decltype(&CabslBehavior::_##name), _CABSL_APPLY(_CABSL_PASS_PARAM, args) _o) \
+    _CABSL_VARS_IMPL(name, vars) \
+    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_PARAM, args) _CABSL_APPLY(_CABSL_PASS_VAR, vars) _o); \
   } \
-  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o)
+  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o)
 
 // Inline, no `args`, `defs`, `vars`
 // Helper needed to handle `defs` and `vars`.
-#define _CABSL_FUNS___1_1(name, class, ...) \
+#define _CABSL_FUNS___1_1(name, class, args, defs, vars) \
   _CABSL_NOARGS_HEAD(name) \
   { \
     _CABSL_DEFS_IMPL(name) \
-    _CABSL_VARS_IMPL(name, __VA_ARGS__) \
-    _##name(_CABSL_APPLY(_CABSL_PASS_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_VAR, _CABSL_GET_VARS(__VA_ARGS__)) _o); \
+    _CABSL_VARS_IMPL(name, vars) \
+    _##name(_CABSL_APPLY(_CABSL_PASS_DEF, defs) _CABSL_APPLY(_CABSL_PASS_VAR, vars) _o); \
   } \
-  void _##name(_CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o)
+  void _##name(_CABSL_APPLY(_CABSL_DECL_DEF, defs) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o)
 
 // Not inline, no `args`, `defs`, `vars`
 // Helper needed to handle `defs` and `vars`.
 // Wrapper class needed to define another method.
-#define _CABSL_FUNS_1__1_1(name, class, ...) \
+#define _CABSL_FUNS_1__1_1(name, class, args, defs, vars) \
   namespace _ns##class \
   { \
     struct name##Wrapper : public class \
     { \
-      void name(_CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o); \
+      void name(_CABSL_APPLY(_CABSL_DECL_DEF, defs) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o); \
     }; \
   } \
   void class::name(const OptionExecution& _o) \
   { \
+    _CABSL_ENTRY(name, void (CabslBehavior::*)(const OptionExecution&), _o) \
     _CABSL_DEFS_IMPL(name) \
-    _CABSL_VARS_IMPL(name, __VA_ARGS__) \
-    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_VAR, _CABSL_GET_VARS(__VA_ARGS__)) _o); \
+    _CABSL_VARS_IMPL(name, vars) \
+    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_DEF, defs) _CABSL_APPLY(_CABSL_PASS_VAR, vars) _o); \
   } \
-  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o)
+  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_DEF, defs) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o)
 
 // Inline, `args`, `defs`, `vars`
 // Helper needed to stream and translate arguments and handle `defs` and `vars`.
-#define _CABSL_FUNS__1_1_1(name, class, ...) \
-  _CABSL_ARGS_HEAD(name, __VA_ARGS__) \
+#define _CABSL_FUNS__1_1_1(name, class, args, defs, vars) \
+  _CABSL_ARGS_HEAD(name, args) \
     _CABSL_DEFS_IMPL(name) \
-    _CABSL_VARS_IMPL(name, __VA_ARGS__) \
-    _##name(_CABSL_APPLY(_CABSL_PASS_ARG, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_VAR, _CABSL_GET_VARS(__VA_ARGS__)) _o); \
+    _CABSL_VARS_IMPL(name, vars) \
+    _##name(_CABSL_APPLY(_CABSL_PASS_ARG, args) _CABSL_APPLY(_CABSL_PASS_DEF, defs) _CABSL_APPLY(_CABSL_PASS_VAR, vars) _o); \
   } \
-  void _##name(_CABSL_APPLY(_CABSL_DECL_ARG, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o)
+  void _##name(_CABSL_APPLY(_CABSL_DECL_ARG, args) _CABSL_APPLY(_CABSL_DECL_DEF, defs) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o)
 
 // Not inline, `args`, `defs`, `vars`
 // Header already handled `args`. Second helper needed to handle `defs` and `vars`.
 // Wrapper class needed to define a third method.
-#define _CABSL_FUNS_1_1_1_1(name, class, ...) \
+#define _CABSL_FUNS_1_1_1_1(name, class, args, defs, vars) \
   namespace _ns##class \
   { \
     struct name##Wrapper : public class \
     { \
-      void name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o); \
+      void name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) _CABSL_APPLY(_CABSL_DECL_DEF, defs) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o); \
     }; \
   } \
-  void class::_##name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) const OptionExecution& _o) \
+  void class::_##name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) const OptionExecution& _o) \
   { \
+    _CABSL_ENTRY(name, decltype(&CabslBehavior::_##name), _CABSL_APPLY(_CABSL_PASS_PARAM, args) _o) \
     _CABSL_DEFS_IMPL(name) \
-    _CABSL_VARS_IMPL(name, __VA_ARGS__) \
-    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_PARAM, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_PASS_VAR, _CABSL_GET_VARS(__VA_ARGS__)) _o); \
+    _CABSL_VARS_IMPL(name, vars) \
+    reinterpret_cast<_ns##class::name##Wrapper*>(this)->name(_CABSL_APPLY(_CABSL_PASS_PARAM, args) _CABSL_APPLY(_CABSL_PASS_DEF, defs) _CABSL_APPLY(_CABSL_PASS_VAR, vars) _o); \
   } \
-  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, _CABSL_GET_ARGS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_DEF, _CABSL_GET_DEFS(__VA_ARGS__)) _CABSL_APPLY(_CABSL_DECL_VAR, _CABSL_GET_VARS(__VA_ARGS__)) const OptionExecution& _o)
+  void _ns##class::name##Wrapper::name(_CABSL_APPLY(_CABSL_DECL_ARG_WITH_INIT, args) _CABSL_APPLY(_CABSL_DECL_DEF, defs) _CABSL_APPLY(_CABSL_DECL_VAR, vars) const OptionExecution& _o)
 
-// Method head for option without arguments.
+// Method head for option without arguments. The overload without parameters is the one
+// called by other options. It takes the instance from `this`.
 #define _CABSL_NOARGS_HEAD(name) \
-  void name(const OptionExecution& _o = OptionExecution(#name, static_cast<CabslBehavior*>(_theInstance)->_##name##Context, _theInstance))
+  void name() \
+  { \
+    name(OptionExecution(#name, _##name##Context, this)); \
+  } \
+  void name(const OptionExecution& _o)
 
-// Method head for option with arguments. Also streams the arguments.
-#define _CABSL_ARGS_HEAD(name, ...) \
-  template<typename U = _##name##Args> typename std::enable_if<std::is_default_constructible<U>::value>::type \
-  name(const OptionExecution& _o = OptionExecution(#name, static_cast<CabslBehavior*>(_theInstance)->_##name##Context, _theInstance)) \
+// Method head for option with arguments. Also signs the arguments and streams them if
+// there is an activation graph.
+#define _CABSL_ARGS_HEAD(name, list) \
+  template<typename U = _##name##Args> typename std::enable_if<std::is_default_constructible<U>::value>::type name() \
   { \
-    name(U(), _o); \
+    name(U(), OptionExecution(#name, _##name##Context, this)); \
   } \
-  void name(const _##name##Args& _args, const OptionExecution& _o = OptionExecution(#name, static_cast<CabslBehavior*>(_theInstance)->_##name##Context, _theInstance)) \
+  void name(const _##name##Args& _args) \
   { \
-    _CABSL_APPLY(_CABSL_STREAM_ARG, _CABSL_GET_ARGS(__VA_ARGS__))
+    name(_args, OptionExecution(#name, _##name##Context, this)); \
+  } \
+  void name(const _##name##Args& _args, const OptionExecution& _o) \
+  { \
+    _CABSL_APPLY(_CABSL_SIGN_ARG, list) \
+    if(_o.describesArguments()) \
+    { \
+      _CABSL_APPLY(_CABSL_STREAM_ARG, list) \
+    }
 
-// Implementation for definitions.
+// Implementation for definitions. They are created here if they were deleted, because
+// the implementation of the option was replaced.
 #define _CABSL_DEFS_IMPL(name) \
   static RegisterFunction<&CabslBehavior::_##name##InitReg> _regInit; \
-  _##name##Defs* _defs = reinterpret_cast<_##name##Defs*>(_o.context.defs);
-
-// Implementation for option variables. If they do not exist yet, they are allocated.
-// In the initial state, they are reset. They are also streamed.
-#define _CABSL_VARS_IMPL(name, ...) \
-  _##name##Vars*& _vars = reinterpret_cast<_##name##Vars*&>(_o.context.vars); \
-  if(!_vars) \
-    _vars = new _##name##Vars(); \
-  if(_o.context.stateType == OptionContext::initialState && !option_time) \
+  if(!_o.context.defs) \
+    CabslBehavior::_##name##Init(this); \
+  _##name##Defs* _defs = _o.context.defs.template get<_##name##Defs>();
+
+// Implementation for option variables. If they do not exist yet, they are created.
+// In the initial state and after allocation, they are reset. They are also streamed if
+// there is an activation graph.
+#define _CABSL_VARS_IMPL(name, list) \
+  const bool _created = !_o.context.vars; \
+  _##name##Vars* _vars = _created ? _o.context.vars.template create<_##name##Vars>() : _o.context.vars.template get<_##name##Vars>(); \
+  if(_created || (_o.context.stateType == OptionContext::initialState && !option_time)) \
+  { \
+    _CABSL_APPLY(_CABSL_INIT_VAR, list) \
+  } \
+  if(!_o.context.restoredVars.empty()) \
   { \
-    _CABSL_APPLY(_CABSL_INIT_VAR, _CABSL_GET_VARS(__VA_ARGS__)) \
+    _vars->_restore(_o.context.restoredVars.data(), _o.context.restoredVars.size()); \
+    _o.context.restoredVars.clear(); \
+  } \
+  if(_o.describesArguments()) \
+  { \
+    _CABSL_APPLY(_CABSL_STREAM_VAR, list) \
   } \
-  _CABSL_APPLY(_CABSL_STREAM_VAR, _CABSL_GET_VARS(__VA_ARGS__)) \
 
 // Assign a value to a variable.
 #define _CABSL_INIT_VAR(seq) _vars->_CABSL_VAR(seq) = _CABSL_INIT_I_2_I(seq);
 
-// Apply a macro to all values in a list.
-#define _CABSL_APPLY(macro, ...) _CABSL_APPLY_I(macro, _CABSL_TUPLE_SIZE(__VA_ARGS__, ignore), __VA_ARGS__)
-#define _CABSL_APPLY_I(macro, n, ...) _CABSL_APPLY_II(n, (macro, __VA_ARGS__, ignore))
-#define _CABSL_APPLY_II(n, pair) _CABSL_ATTR_##n pair
+// Apply a macro to all values in a parenthesized list. The list is expanded
+// before it is checked for being empty.
+#define _CABSL_APPLY(macro, list) _CABSL_APPLY_I(macro, _CABSL_UNPAREN list)
+#define _CABSL_APPLY_I(macro, ...) _CABSL_APPLY_II(macro, __VA_ARGS__)
+#define _CABSL_APPLY_II(macro, ...) __VA_OPT__(_CABSL_APPLY_1(macro, __VA_ARGS__))
 
 // Generate an initialization if the declaration contains one.
 #define _CABSL_INIT(seq) _CABSL_JOIN(_CABSL_INIT_I_, _CABSL_SEQ_SIZE(seq))(seq)
@@ -958,21 +2091,25 @@ namespace cabsl
 // Generate code for streaming an argument and adding it to the arguments stored in the execution environment.
 #define _CABSL_STREAM_ARG(seq) \
   _CABSL_JOIN(_CABSL_STREAM_ARG_, _CABSL_SEQ_SIZE(seq))(seq) \
-    _o.addArgument(#seq, _args._CABSL_VAR(seq));
+    _o.addArgument(#seq, cabsl::argValue(_args._CABSL_VAR(seq)));
+
+// Add an argument to the frame signature.
+#define _CABSL_SIGN_ARG(seq) _o.signArgument(cabsl::argValue(_args._CABSL_VAR(seq)));
 
 // If a default value exists, only stream arguments that are different from it.
 #define _CABSL_STREAM_ARG_1(seq)
 #define _CABSL_STREAM_ARG_2(seq) if(const decltype(_args._CABSL_VAR(seq))& _p = _CABSL_INIT_I_2_I(seq); \
-    !(_args._CABSL_VAR(seq) == _p))
+    !(cabsl::argValue(_args._CABSL_VAR(seq)) == cabsl::argValue(_p)))
 
 // Generate an argument declaration for the formal arguments of a method.
-#define _CABSL_DECL_ARG(seq) decltype(cabsl::TypeWrapper<_CABSL_DECL_I seq))>::type) _CABSL_VAR(seq),
+// Arguments that are not small are passed by const reference.
+#define _CABSL_DECL_ARG(seq) cabsl::ArgParam<decltype(cabsl::TypeWrapper<_CABSL_DECL_I seq))>::type)> _CABSL_VAR(seq),
 
 // Generate an argument declaration with initialization for the formal arguments of a method.
-#define _CABSL_DECL_ARG_WITH_INIT(seq) decltype(cabsl::TypeWrapper<_CABSL_DECL_I seq))>::type) _CABSL_VAR(seq) _CABSL_INIT(seq),
+#define _CABSL_DECL_ARG_WITH_INIT(seq) cabsl::ArgParam<decltype(cabsl::TypeWrapper<_CABSL_DECL_I seq))>::type)> _CABSL_VAR(seq) _CABSL_INIT(seq),
 
 // Generate a variable name for the list of actual arguments of a method call.
-#define _CABSL_PASS_ARG(seq) _args._CABSL_VAR(seq),
+#define _CABSL_PASS_ARG(seq) cabsl::argValue(_args._CABSL_VAR(seq)),
 
 // Directly forward an argument.
 #define _CABSL_PASS_PARAM(seq) _CABSL_VAR(seq),
@@ -993,75 +2130,59 @@ namespace cabsl
 // Generate a variable name for the list of actual arguments of a method call.
 #define _CABSL_PASS_VAR(seq) _vars->_CABSL_VAR(seq),
 
+// Apply `_CABSL_<what>_` to each of the three parameters of an option. Parameters not
+// specified are empty, i.e. `_CABSL_<what>_` alone must be defined as well. It must not
+// be expanded before it is joined, so _CABSL_JOIN_I is used directly.
+#define _CABSL_PARAMS(what, p1, p2, p3) _CABSL_JOIN_I(_CABSL_##what##_, p1) _CABSL_JOIN_I(_CABSL_##what##_, p2) _CABSL_JOIN_I(_CABSL_##what##_, p3)
+
 // Does a list contain an `args()` parameter? Empty or `1`.
-#define _CABSL_HAS_ARGS(...) _CABSL_HAS_ARGS_I(_CABSL_TUPLE_SIZE(__VA_ARGS__, ignore), __VA_ARGS__, ignore)
-#define _CABSL_HAS_ARGS_I(n, ...) _CABSL_HAS_ARGS_II(n, (_CABSL_HAS_ARGS_III, __VA_ARGS__))
-#define _CABSL_HAS_ARGS_II(n, pair, ...) _CABSL_ATTR_##n pair
-#define _CABSL_HAS_ARGS_III(entry) _CABSL_JOIN(_CABSL_HAS_ARGS_III_, entry)
-#define _CABSL_HAS_ARGS_III_args(...) 1
-#define _CABSL_HAS_ARGS_III_defs(...)
-#define _CABSL_HAS_ARGS_III_load(...)
-#define _CABSL_HAS_ARGS_III_vars(...)
+#define _CABSL_HAS_ARGS_
+#define _CABSL_HAS_ARGS_args(...) 1
+#define _CABSL_HAS_ARGS_defs(...)
+#define _CABSL_HAS_ARGS_load(...)
+#define _CABSL_HAS_ARGS_vars(...)
 
 // Return the contents of the `args()` parameter in a list.
-#define _CABSL_GET_ARGS(...) _CABSL_GET_ARGS_I(_CABSL_TUPLE_SIZE(__VA_ARGS__, ignore), __VA_ARGS__, ignore)
-#define _CABSL_GET_ARGS_I(n, ...) _CABSL_GET_ARGS_II(n, (_CABSL_GET_ARGS_III, __VA_ARGS__))
-#define _CABSL_GET_ARGS_II(n, pair, ...) _CABSL_ATTR_##n pair
-#define _CABSL_GET_ARGS_III(entry) _CABSL_JOIN(_CABSL_GET_ARGS_III_, entry)
-#define _CABSL_GET_ARGS_III_args(...) __VA_ARGS__
-#define _CABSL_GET_ARGS_III_defs(...)
-#define _CABSL_GET_ARGS_III_load(...)
-#define _CABSL_GET_ARGS_III_vars(...)
+#define _CABSL_GET_ARGS_
+#define _CABSL_GET_ARGS_args(...) __VA_ARGS__
+#define _CABSL_GET_ARGS_defs(...)
+#define _CABSL_GET_ARGS_load(...)
+#define _CABSL_GET_ARGS_vars(...)
 
 // Does a list contain a `defs()` or `load()` parameter? Empty or `1`.
-#define _CABSL_HAS_DEFS(...) _CABSL_HAS_DEFS_I(_CABSL_TUPLE_SIZE(__VA_ARGS__, ignore), __VA_ARGS__, ignore)
-#define _CABSL_HAS_DEFS_I(n, ...) _CABSL_HAS_DEFS_II(n, (_CABSL_HAS_DEFS_III, __VA_ARGS__))
-#define _CABSL_HAS_DEFS_II(n, pair, ...) _CABSL_ATTR_##n pair
-#define _CABSL_HAS_DEFS_III(entry) _CABSL_JOIN(_CABSL_HAS_DEFS_III_, entry)
-#define _CABSL_HAS_DEFS_III_args(...)
-#define _CABSL_HAS_DEFS_III_defs(...) 1
-#define _CABSL_HAS_DEFS_III_load(...) 1
-#define _CABSL_HAS_DEFS_III_vars(...)
+#define _CABSL_HAS_DEFS_
+#define _CABSL_HAS_DEFS_args(...)
+#define _CABSL_HAS_DEFS_defs(...) 1
+#define _CABSL_HAS_DEFS_load(...) 1
+#define _CABSL_HAS_DEFS_vars(...)
 
 // Does a list contain a `load()` parameter? Empty or `1`.
-#define _CABSL_HAS_LOAD(...) _CABSL_HAS_LOAD_I(_CABSL_TUPLE_SIZE(__VA_ARGS__, ignore), __VA_ARGS__, ignore)
-#define _CABSL_HAS_LOAD_I(n, ...) _CABSL_HAS_LOAD_II(n, (_CABSL_HAS_LOAD_III, __VA_ARGS__))
-#define _CABSL_HAS_LOAD_II(n, pair, ...) _CABSL_ATTR_##n pair
-#define _CABSL_HAS_LOAD_III(entry) _CABSL_JOIN(_CABSL_HAS_LOAD_III_, entry)
-#define _CABSL_HAS_LOAD_III_args(...)
-#define _CABSL_HAS_LOAD_III_defs(...)
-#define _CABSL_HAS_LOAD_III_load(...) 1
-#define _CABSL_HAS_LOAD_III_vars(...)
+#define _CABSL_HAS_LOAD_
+#define _CABSL_HAS_LOAD_args(...)
+#define _CABSL_HAS_LOAD_defs(...)
+#define _CABSL_HAS_LOAD_load(...) 1
+#define _CABSL_HAS_LOAD_vars(...)
 
 // Return the contents of the `defs()` or `load()` parameter in a list.
-#define _CABSL_GET_DEFS(...) _CABSL_GET_DEFS_I(_CABSL_TUPLE_SIZE(__VA_ARGS__, ignore), __VA_ARGS__, ignore)
-#define _CABSL_GET_DEFS_I(n, ...) _CABSL_GET_DEFS_II(n, (_CABSL_GET_DEFS_III, __VA_ARGS__))
-#define _CABSL_GET_DEFS_II(n, pair, ...) _CABSL_ATTR_##n pair
-#define _CABSL_GET_DEFS_III(entry) _CABSL_JOIN(_CABSL_GET_DEFS_III_, entry)
-#define _CABSL_GET_DEFS_III_args(...)
-#define _CABSL_GET_DEFS_III_defs(...) __VA_ARGS__
-#define _CABSL_GET_DEFS_III_load(...) __VA_ARGS__
-#define _CABSL_GET_DEFS_III_vars(...)
+#define _CABSL_GET_DEFS_
+#define _CABSL_GET_DEFS_args(...)
+#define _CABSL_GET_DEFS_defs(...) __VA_ARGS__
+#define _CABSL_GET_DEFS_load(...) __VA_ARGS__
+#define _CABSL_GET_DEFS_vars(...)
 
 // Does a list contain a `vars()` parameter? Empty or `1`.
-#define _CABSL_HAS_VARS(...) _CABSL_HAS_VARS_I(_CABSL_TUPLE_SIZE(__VA_ARGS__, ignore), __VA_ARGS__, ignore)
-#define _CABSL_HAS_VARS_I(n, ...) _CABSL_HAS_VARS_II(n, (_CABSL_HAS_VARS_III, __VA_ARGS__))
-#define _CABSL_HAS_VARS_II(n, pair, ...) _CABSL_ATTR_##n pair
-#define _CABSL_HAS_VARS_III(entry) _CABSL_JOIN(_CABSL_HAS_VARS_III_, entry)
-#define _CABSL_HAS_VARS_III_args(...)
-#define _CABSL_HAS_VARS_III_defs(...)
-#define _CABSL_HAS_VARS_III_load(...)
-#define _CABSL_HAS_VARS_III_vars(...) 1
+#define _CABSL_HAS_VARS_
+#define _CABSL_HAS_VARS_args(...)
+#define _CABSL_HAS_VARS_defs(...)
+#define _CABSL_HAS_VARS_load(...)
+#define _CABSL_HAS_VARS_vars(...) 1
 
 // Return the contents of the `vars()` parameter in a list.
-#define _CABSL_GET_VARS(...) _CABSL_GET_VARS_I(_CABSL_TUPLE_SIZE(__VA_ARGS__, ignore), __VA_ARGS__, ignore)
-#define _CABSL_GET_VARS_I(n, ...) _CABSL_GET_VARS_II(n, (_CABSL_GET_VARS_III, __VA_ARGS__))
-#define _CABSL_GET_VARS_II(n, pair, ...) _CABSL_ATTR_##n pair
-#define _CABSL_GET_VARS_III(entry) _CABSL_JOIN(_CABSL_GET_VARS_III_, entry)
-#define _CABSL_GET_VARS_III_args(...)
-#define _CABSL_GET_VARS_III_defs(...)
-#define _CABSL_GET_VARS_III_load(...)
-#define _CABSL_GET_VARS_III_vars(...) __VA_ARGS__
+#define _CABSL_GET_VARS_
+#define _CABSL_GET_VARS_args(...)
+#define _CABSL_GET_VARS_defs(...)
+#define _CABSL_GET_VARS_load(...)
+#define _CABSL_GET_VARS_vars(...) __VA_ARGS__
 
 #ifndef __INTELLISENSE__
 
@@ -1081,18 +2202,27 @@ namespace cabsl
 /**
  * The actual code generated for the state macros above.
  * An unreachable goto statement ensures that there is an initial state.
+ * The state is registered during static initialization. The name of the
+ * option is taken from the name of the function that implements it.
  * @param name The name of the state.
- * @param line The line number in which the state is defined of 0 for the initial state.
+ * @param id The identifier of the state or 0 for the initial state.
  * @param stateType The type of the state.
  */
-#define _state(name, line, stateType) \
+#define _state(name, id, stateType) \
   if(false) \
   { \
+    static constexpr const char* _optionName = __func__; \
+    static constexpr int _id = id; \
+    static_cast<void>(RegisterState<decltype([]() -> const StateDescriptor& \
+    { \
+      static constexpr StateDescriptor descriptor{_optionName, #name, stateType, _id, __LINE__}; \
+      return descriptor; \
+    })>::registered); \
     goto initial_state; \
-  name: _o.updateState(line, stateType); \
+  name: _o.updateState(id, #name, stateType); \
   } \
   _o.context.hasCommonTransition = false; \
-  if(_o.context.state == line && (_o.context.stateName = #name))
+  if(_o.context.state == id && (_o.context.stateName = #name))
 
 /**
  * The macro marks a common transition. It sets a flag so that a transition is accepted,
@@ -1143,25 +2273,13 @@ namespace cabsl
 #ifndef INTELLISENSE_PREFIX
 #define INTELLISENSE_PREFIX
 #endif
-#define _CABSL_OPTION_0_0(name) void INTELLISENSE_PREFIX name(const OptionExecution&)
-#define _CABSL_OPTION_III(n, name, ...) _CABSL_OPTION_IV(n, name, (_CABSL_STRUCT_WITH_INIT, __VA_ARGS__), (_CABSL_ARG_WITH_INIT, __VA_ARGS__))
-#define _CABSL_OPTION_IV(n, name, params1, params2) \
-  struct INTELLISENSE_PREFIX _##name##Args \
-  { \
-    _CABSL_ATTR_##n params1 \
-  }; \
-  void INTELLISENSE_PREFIX name(const _##name##Args& args, const OptionExecution&) {} \
-  void INTELLISENSE_PREFIX _##name(_CABSL_ATTR_##n params2 const OptionExecution&)
-#define _CABSL_IOPTION_IV(n, class, name, params1) \
-  void _CABSL_DECL_I class))::_##name(_CABSL_ATTR_##n params1 const OptionExecution&)
-
 #define initial_state(name) \
   initial_state: \
   if(false) \
     goto name; \
   _state(name, 0, )
 
-#define _state(name, line, stateType) \
+#define _state(name, id, stateType) \
   if(false) \
   { \
     goto initial_state; \
@@ -1180,22 +2298,6 @@ namespace cabsl
 
 #endif
 
-/** Determine the number of entries in a tuple. */
-#define _CABSL_TUPLE_SIZE(...) _CABSL_TUPLE_SIZE_I((__VA_ARGS__, _CABSL_TUPLE_SIZE_III))
-#define _CABSL_TUPLE_SIZE_I(params) _CABSL_TUPLE_SIZE_II params
-#define _CABSL_TUPLE_SIZE_II( \
-  a0, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, \
-  a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, \
-  a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54, a55, a56, a57, a58, a59, a60, \
-  a61, a62, a63, a64, a65, a66, a67, a68, a69, a70, a71, a72, a73, a74, a75, a76, a77, a78, a79, a80, \
-  a81, a82, a83, a84, a85, a86, a87, a88, a89, a90, a91, a92, a93, a94, a95, a96, a97, a98, a99, a100, ...) a100
-#define _CABSL_TUPLE_SIZE_III \
-  100, 99, 98, 97, 96, 95, 94, 93, 92, 91, 90, 89, 88, 87, 86, 85, 84, 83, 82, 81, 80, \
-  79, 78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, \
-  59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, \
-  39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, \
-  19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1
-
 /**
  * Determine whether a sequence is of the form `(a) b` or `(a)(b) c`.
  * In the first case, 1 is returned, otherwise 2.
@@ -1208,69 +2310,72 @@ namespace cabsl
 #define _CABSL_SEQ_SIZE_CABSL_SEQ_SIZE_2 2 _CABSL_DROP(
 
 /**
- * Apply a macro to all elements of a tuple.
+ * Apply a macro to all elements of a list. Each step applies the macro to the first
+ * element and continues with the rest, so no counting is required.
  */
-#define _CABSL_ATTR_1(f, a1)
-#define _CABSL_ATTR_2(f, a1, a2) f(a1)
-#define _CABSL_ATTR_3(f, a1, a2, a3) f(a1) f(a2)
-#define _CABSL_ATTR_4(f, a1, a2, a3, a4) f(a1) f(a2) f(a3)
-#define _CABSL_ATTR_5(f, a1, a2, a3, a4, a5) f(a1) f(a2) f(a3) f(a4)
-#define _CABSL_ATTR_6(f, a1, a2, a3, a4, a5, a6) f(a1) f(a2) f(a3) f(a4) f(a5)
-#define _CABSL_ATTR_7(f, a1, a2, a3, a4, a5, a6, a7) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6)
-#define _CABSL_ATTR_8(f, a1, a2, a3, a4, a5, a6, a7, a8) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7)
-#define _CABSL_ATTR_9(f, a1, a2, a3, a4, a5, a6, a7, a8, a9) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8)
-#define _CABSL_ATTR_10(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9)
-#define _CABSL_ATTR_11(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10)
-#define _CABSL_ATTR_12(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11)
-#define _CABSL_ATTR_13(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12)
-#define _CABSL_ATTR_14(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13)
-#define _CABSL_ATTR_15(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14)
-#define _CABSL_ATTR_16(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15)
-#define _CABSL_ATTR_17(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16)
-#define _CABSL_ATTR_18(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17)
-#define _CABSL_ATTR_19(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18)
-#define _CABSL_ATTR_20(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19)
-#define _CABSL_ATTR_21(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20)
-#define _CABSL_ATTR_22(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21)
-#define _CABSL_ATTR_23(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22)
-#define _CABSL_ATTR_24(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23)
-#define _CABSL_ATTR_25(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24)
-#define _CABSL_ATTR_26(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25)
-#define _CABSL_ATTR_27(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26)
-#define _CABSL_ATTR_28(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27)
-#define _CABSL_ATTR_29(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28)
-#define _CABSL_ATTR_30(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29)
-#define _CABSL_ATTR_31(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30)
-#define _CABSL_ATTR_32(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31)
-#define _CABSL_ATTR_33(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32)
-#define _CABSL_ATTR_34(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33)
-#define _CABSL_ATTR_35(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34)
-#define _CABSL_ATTR_36(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35)
-#define _CABSL_ATTR_37(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36)
-#define _CABSL_ATTR_38(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37)
-#define _CABSL_ATTR_39(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38)
-#define _CABSL_ATTR_40(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39)
-#define _CABSL_ATTR_41(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40)
-#define _CABSL_ATTR_42(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41)
-#define _CABSL_ATTR_43(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42)
-#define _CABSL_ATTR_44(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43)
-#define _CABSL_ATTR_45(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44)
-#define _CABSL_ATTR_46(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45)
-#define _CABSL_ATTR_47(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46)
-#define _CABSL_ATTR_48(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47)
-#define _CABSL_ATTR_49(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48)
-#define _CABSL_ATTR_50(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49)
-#define _CABSL_ATTR_51(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50)
-#define _CABSL_ATTR_52(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51)
-#define _CABSL_ATTR_53(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52)
-#define _CABSL_ATTR_54(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52) f(a53)
-#define _CABSL_ATTR_55(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54, a55) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52) f(a53) f(a54)
-#define _CABSL_ATTR_56(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54, a55, a56) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52) f(a53) f(a54) f(a55)
-#define _CABSL_ATTR_57(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54, a55, a56, a57) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52) f(a53) f(a54) f(a55) f(a56)
-#define _CABSL_ATTR_58(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54, a55, a56, a57, a58) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52) f(a53) f(a54) f(a55) f(a56) f(a57)
-#define _CABSL_ATTR_59(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54, a55, a56, a57, a58, a59) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52) f(a53) f(a54) f(a55) f(a56) f(a57) f(a58)
-#define _CABSL_ATTR_60(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54, a55, a56, a57, a58, a59, a60) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52) f(a53) f(a54) f(a55) f(a56) f(a57) f(a58) f(a59)
-#define _CABSL_ATTR_61(f, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, a17, a18, a19, a20, a21, a22, a23, a24, a25, a26, a27, a28, a29, a30, a31, a32, a33, a34, a35, a36, a37, a38, a39, a40, a41, a42, a43, a44, a45, a46, a47, a48, a49, a50, a51, a52, a53, a54, a55, a56, a57, a58, a59, a60, a61) f(a1) f(a2) f(a3) f(a4) f(a5) f(a6) f(a7) f(a8) f(a9) f(a10) f(a11) f(a12) f(a13) f(a14) f(a15) f(a16) f(a17) f(a18) f(a19) f(a20) f(a21) f(a22) f(a23) f(a24) f(a25) f(a26) f(a27) f(a28) f(a29) f(a30) f(a31) f(a32) f(a33) f(a34) f(a35) f(a36) f(a37) f(a38) f(a39) f(a40) f(a41) f(a42) f(a43) f(a44) f(a45) f(a46) f(a47) f(a48) f(a49) f(a50) f(a51) f(a52) f(a53) f(a54) f(a55) f(a56) f(a57) f(a58) f(a59) f(a60)
+#define _CABSL_APPLY_1(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_2(f, __VA_ARGS__))
+#define _CABSL_APPLY_2(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_3(f, __VA_ARGS__))
+#define _CABSL_APPLY_3(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_4(f, __VA_ARGS__))
+#define _CABSL_APPLY_4(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_5(f, __VA_ARGS__))
+#define _CABSL_APPLY_5(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_6(f, __VA_ARGS__))
+#define _CABSL_APPLY_6(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_7(f, __VA_ARGS__))
+#define _CABSL_APPLY_7(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_8(f, __VA_ARGS__))
+#define _CABSL_APPLY_8(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_9(f, __VA_ARGS__))
+#define _CABSL_APPLY_9(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_10(f, __VA_ARGS__))
+#define _CABSL_APPLY_10(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_11(f, __VA_ARGS__))
+#define _CABSL_APPLY_11(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_12(f, __VA_ARGS__))
+#define _CABSL_APPLY_12(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_13(f, __VA_ARGS__))
+#define _CABSL_APPLY_13(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_14(f, __VA_ARGS__))
+#define _CABSL_APPLY_14(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_15(f, __VA_ARGS__))
+#define _CABSL_APPLY_15(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_16(f, __VA_ARGS__))
+#define _CABSL_APPLY_16(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_17(f, __VA_ARGS__))
+#define _CABSL_APPLY_17(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_18(f, __VA_ARGS__))
+#define _CABSL_APPLY_18(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_19(f, __VA_ARGS__))
+#define _CABSL_APPLY_19(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_20(f, __VA_ARGS__))
+#define _CABSL_APPLY_20(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_21(f, __VA_ARGS__))
+#define _CABSL_APPLY_21(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_22(f, __VA_ARGS__))
+#define _CABSL_APPLY_22(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_23(f, __VA_ARGS__))
+#define _CABSL_APPLY_23(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_24(f, __VA_ARGS__))
+#define _CABSL_APPLY_24(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_25(f, __VA_ARGS__))
+#define _CABSL_APPLY_25(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_26(f, __VA_ARGS__))
+#define _CABSL_APPLY_26(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_27(f, __VA_ARGS__))
+#define _CABSL_APPLY_27(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_28(f, __VA_ARGS__))
+#define _CABSL_APPLY_28(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_29(f, __VA_ARGS__))
+#define _CABSL_APPLY_29(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_30(f, __VA_ARGS__))
+#define _CABSL_APPLY_30(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_31(f, __VA_ARGS__))
+#define _CABSL_APPLY_31(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_32(f, __VA_ARGS__))
+#define _CABSL_APPLY_32(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_33(f, __VA_ARGS__))
+#define _CABSL_APPLY_33(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_34(f, __VA_ARGS__))
+#define _CABSL_APPLY_34(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_35(f, __VA_ARGS__))
+#define _CABSL_APPLY_35(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_36(f, __VA_ARGS__))
+#define _CABSL_APPLY_36(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_37(f, __VA_ARGS__))
+#define _CABSL_APPLY_37(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_38(f, __VA_ARGS__))
+#define _CABSL_APPLY_38(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_39(f, __VA_ARGS__))
+#define _CABSL_APPLY_39(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_40(f, __VA_ARGS__))
+#define _CABSL_APPLY_40(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_41(f, __VA_ARGS__))
+#define _CABSL_APPLY_41(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_42(f, __VA_ARGS__))
+#define _CABSL_APPLY_42(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_43(f, __VA_ARGS__))
+#define _CABSL_APPLY_43(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_44(f, __VA_ARGS__))
+#define _CABSL_APPLY_44(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_45(f, __VA_ARGS__))
+#define _CABSL_APPLY_45(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_46(f, __VA_ARGS__))
+#define _CABSL_APPLY_46(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_47(f, __VA_ARGS__))
+#define _CABSL_APPLY_47(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_48(f, __VA_ARGS__))
+#define _CABSL_APPLY_48(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_49(f, __VA_ARGS__))
+#define _CABSL_APPLY_49(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_50(f, __VA_ARGS__))
+#define _CABSL_APPLY_50(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_51(f, __VA_ARGS__))
+#define _CABSL_APPLY_51(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_52(f, __VA_ARGS__))
+#define _CABSL_APPLY_52(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_53(f, __VA_ARGS__))
+#define _CABSL_APPLY_53(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_54(f, __VA_ARGS__))
+#define _CABSL_APPLY_54(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_55(f, __VA_ARGS__))
+#define _CABSL_APPLY_55(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_56(f, __VA_ARGS__))
+#define _CABSL_APPLY_56(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_57(f, __VA_ARGS__))
+#define _CABSL_APPLY_57(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_58(f, __VA_ARGS__))
+#define _CABSL_APPLY_58(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_59(f, __VA_ARGS__))
+#define _CABSL_APPLY_59(f, a, ...) f(a) __VA_OPT__(_CABSL_APPLY_60(f, __VA_ARGS__))
+#define _CABSL_APPLY_60(f, a) f(a)
+
+/** Remove the parentheses around a list. */
+#define _CABSL_UNPAREN(...) __VA_ARGS__
 
 /** Simply drop all parameters passed. */
 #define _CABSL_DROP(...)
@@ -1287,6 +2392,11 @@ namespace cabsl
 /** Generate the actual declaration. */
 #define _CABSL_DECL_I(...) _CABSL_VAR(__VA_ARGS__) _CABSL_DROP(_CABSL_DROP(
 
+/** Extract the variable from the declaration as a string. */
+#define _CABSL_NAME(...) _CABSL_NAME_I(_CABSL_VAR(__VA_ARGS__))
+#define _CABSL_NAME_I(...) _CABSL_NAME_II(__VA_ARGS__)
+#define _CABSL_NAME_II(...) #__VA_ARGS__
+
 /** Extract the variable from the declaration. */
 #define _CABSL_VAR(...) _CABSL_JOIN(_CABSL_VAR_, _CABSL_SEQ_SIZE(__VA_ARGS__))(__VA_ARGS__)
 #define _CABSL_VAR_0(...) __VA_ARGS__
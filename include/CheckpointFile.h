@@ -0,0 +1,174 @@
+/**
+ * @file CheckpointFile.h
+ *
+ * A memory-mapped file that holds the latest checkpoint of a behavior (see
+ * `Cabsl::saveCheckpoint`). It contains two slots. A checkpoint is always
+ * written to the slot that is not current, which then becomes the current
+ * one. Therefore, a process that is killed while writing leaves the previous
+ * checkpoint intact. Since the pages are shared with the kernel, the data
+ * survives the termination of the process without an explicit flush. Only
+ * a crash of the whole system requires `sync`.
+ *
+ * Example:
+ *
+ *     cabsl::CheckpointFile file;
+ *     std::vector<char> checkpoint;
+ *     if(file.open("behavior.checkpoint", 1 << 16) && file.read(checkpoint))
+ *       behavior.restoreCheckpoint(checkpoint.data(), checkpoint.size(), time);
+ *     for(;; time += 10)
+ *     {
+ *       behavior.beginFrame(time);
+ *       behavior.execute("root");
+ *       behavior.endFrame();
+ *       behavior.saveCheckpoint(checkpoint);
+ *       file.write(checkpoint);
+ *     }
+ */
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace cabsl
+{
+  class CheckpointFile
+  {
+    /** The beginning of the file. */
+    struct Header
+    {
+      char magic[8]; /**< Identifies the file format. */
+      std::uint64_t capacity; /**< The maximum size of a checkpoint in bytes. */
+      std::atomic<std::uint32_t> current; /**< The index of the slot that contains the latest checkpoint. */
+      std::uint32_t valid; /**< A bit set of the slots that contain a checkpoint. */
+    };
+
+    /** A slot that contains a checkpoint. It is followed by the data. */
+    struct Slot
+    {
+      std::uint64_t size; /**< The size of the checkpoint in bytes. */
+    };
+
+    static constexpr char magic[] = "CABSLCF1"; /**< The identifier at the beginning of the file. */
+
+    char* memory = nullptr; /**< The memory the file is mapped to. */
+    size_t length = 0; /**< The length of the mapping in bytes. */
+    std::uint64_t capacity = 0; /**< The maximum size of a checkpoint in bytes. */
+
+    /**
+     * Returns the header of the file.
+     * @return The header.
+     */
+    Header& header() const {return *reinterpret_cast<Header*>(memory);}
+
+    /**
+     * Returns a slot of the file.
+     * @param index The index of the slot (0 or 1).
+     * @return The slot.
+     */
+    Slot& slot(std::uint32_t index) const
+    {
+      return *reinterpret_cast<Slot*>(memory + sizeof(Header) + index * (sizeof(Slot) + capacity));
+    }
+
+  public:
+    CheckpointFile() = default;
+    CheckpointFile(const CheckpointFile&) = delete;
+    CheckpointFile& operator=(const CheckpointFile&) = delete;
+
+    /** The destructor unmaps the file. */
+    ~CheckpointFile() {close();}
+
+    /**
+     * Opens a checkpoint file. It is created if it does not exist yet. An
+     * existing file is only used if it has the same capacity. Otherwise, its
+     * checkpoints are discarded.
+     * @param path The path to the file.
+     * @param capacity The maximum size of a checkpoint in bytes.
+     * @return Could the file be opened?
+     */
+    bool open(const std::string& path, size_t capacity)
+    {
+      close();
+      capacity = (capacity + 7) & ~size_t(7);
+      const size_t length = sizeof(Header) + 2 * (sizeof(Slot) + capacity);
+      const int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+      if(fd == -1)
+        return false;
+      struct stat status;
+      const bool reuse = fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) == length;
+      if(!reuse && ftruncate(fd, static_cast<off_t>(length)) != 0)
+      {
+        ::close(fd);
+        return false;
+      }
+      void* memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      ::close(fd);
+      if(memory == MAP_FAILED)
+        return false;
+      this->memory = static_cast<char*>(memory);
+      this->length = length;
+      this->capacity = capacity;
+      if(!reuse || std::memcmp(header().magic, magic, sizeof(header().magic)) || header().capacity != capacity)
+      {
+        std::memset(this->memory, 0, sizeof(Header));
+        header().capacity = capacity;
+        std::memcpy(header().magic, magic, sizeof(header().magic));
+      }
+      return true;
+    }
+
+    /** Unmaps the file if it is open. */
+    void close()
+    {
+      if(memory)
+        munmap(memory, length);
+      memory = nullptr;
+      length = 0;
+      capacity = 0;
+    }
+
+    /**
+     * Writes a checkpoint. It becomes the current one.
+     * @param checkpoint The checkpoint.
+     * @return Was it written? It is not if the file is not open or the
+     *         checkpoint exceeds the capacity.
+     */
+    bool write(const std::vector<char>& checkpoint)
+    {
+      if(!memory || checkpoint.size() > capacity)
+        return false;
+      const std::uint32_t index = 1 - header().current.load(std::memory_order_relaxed);
+      Slot& slot = this->slot(index);
+      slot.size = checkpoint.size();
+      std::memcpy(&slot + 1, checkpoint.data(), checkpoint.size());
+      header().valid |= 1u << index;
+      header().current.store(index, std::memory_order_release);
+      return true;
+    }
+
+    /**
+     * Reads the current checkpoint.
+     * @param checkpoint The checkpoint is copied to this buffer.
+     * @return Was there a checkpoint?
+     */
+    bool read(std::vector<char>& checkpoint) const
+    {
+      if(!memory)
+        return false;
+      const std::uint32_t index = header().current.load(std::memory_order_acquire);
+      if(index > 1 || !(header().valid & 1u << index) || slot(index).size > capacity)
+        return false;
+      const char* data = reinterpret_cast<const char*>(&slot(index) + 1);
+      checkpoint.assign(data, data + slot(index).size);
+      return true;
+    }
+  };
+}
@@ -0,0 +1,188 @@
+/**
+ * @file EdgeStatistics.h
+ *
+ * Counts which edges of the behavior graph are actually used at runtime:
+ * state transitions within each option (from-state to to-state) as well as
+ * calls of sub-options from the states of their callers. It also counts how
+ * often each option was executed in each state and how much time the
+ * executions took. The statistics can be written to a file that the script
+ * `bin/createGraphs` reads (switch `-s`) to color and weight the nodes and
+ * edges of the graphs, so that hot paths and dead states become visible.
+ *
+ * The file contains one entry per line:
+ *
+ *     transition <option> <from-state> <to-state> <count>
+ *     call <option> <state> <sub-option> <count> <time in µs>
+ *     state <option> <state> <count> <time in µs>
+ *
+ * Example:
+ *
+ *     cabsl::EdgeStatistics edgeStatistics("edges.txt");
+ *     behavior.setEdgeStatistics(&edgeStatistics);
+ *
+ * The file is written when the object is destroyed.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace cabsl
+{
+  class EdgeStatistics
+  {
+    /** The statistics of a node or an edge. */
+    struct Entry
+    {
+      std::uint64_t count = 0; /**< How often was it used? */
+      std::uint64_t time = 0; /**< The time spent in ns (not used for transitions). */
+    };
+
+    /** An option currently executed. */
+    struct Call
+    {
+      const char* option; /**< The name of the option. */
+      const char* const* state; /**< The address of the name of the option's current state. */
+      std::chrono::steady_clock::time_point start; /**< When did the execution start? */
+    };
+
+    using Key = std::tuple<const char*, const char*, const char*>; /**< Names of option, state, and state/sub-option. */
+
+    std::vector<Call> calls; /**< The options currently executed. */
+    std::map<Key, Entry> transitions; /**< The state transitions, indexed by the addresses of option, from-state, and to-state names. */
+    std::map<Key, Entry> callEdges; /**< The calls, indexed by the addresses of option, state, and sub-option names. */
+    std::map<Key, Entry> states; /**< The executions per state, indexed by the addresses of option and state names. */
+    std::unordered_map<std::string, std::string> initialStates; /**< The names of the initial states, indexed by option names. */
+    std::string filename; /**< The file the statistics are written to when destroyed. Ignored if empty. */
+
+    /**
+     * Merges entries that have the same names.
+     * @param entries The entries, indexed by the addresses of the names.
+     * @param resolveInitial Replace unknown states by the initial state of the option.
+     *                       Otherwise, entries with unknown states are skipped.
+     * @return The entries, indexed by the names separated by spaces.
+     */
+    std::map<std::string, Entry> merge(const std::map<Key, Entry>& entries, bool resolveInitial) const
+    {
+      std::map<std::string, Entry> merged;
+      for(const auto& [key, entry] : entries)
+      {
+        std::string second;
+        if(std::get<1>(key))
+          second = std::get<1>(key);
+        else if(resolveInitial)
+        {
+          // The state was not known yet, because the option was just (re)activated.
+          const auto initial = initialStates.find(std::get<0>(key));
+          if(initial == initialStates.end())
+            continue;
+          second = initial->second;
+        }
+        else
+          continue;
+        Entry& sum = merged[std::string(std::get<0>(key)) + ' ' + second + (std::get<2>(key) ? std::string(" ") + std::get<2>(key) : std::string())];
+        sum.count += entry.count;
+        sum.time += entry.time;
+      }
+      return merged;
+    }
+
+  public:
+    /**
+     * Constructor.
+     * @param filename The file the statistics are written to when the object is destroyed.
+     *                 Nothing is written if it is empty.
+     */
+    EdgeStatistics(const std::string& filename = "") :
+      filename(filename)
+    {
+      calls.reserve(32);
+    }
+
+    /** The destructor writes the file that was specified in the constructor. */
+    ~EdgeStatistics()
+    {
+      if(!filename.empty())
+      {
+        std::ofstream stream(filename);
+        write(stream);
+      }
+    }
+
+    /**
+     * Records that an option begins.
+     * @param option The name of the option.
+     * @param state The address of the name of the option's current state.
+     */
+    void enter(const char* option, const char* const* state)
+    {
+      calls.push_back({option, state, std::chrono::steady_clock::now()});
+    }
+
+    /**
+     * Records that the option entered last ends.
+     * @param initial Did the option end in its initial state?
+     */
+    void exit(bool initial)
+    {
+      const Call& call = calls.back();
+      const std::uint64_t time = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - call.start).count());
+      if(*call.state)
+      {
+        Entry& state = states[{call.option, *call.state, nullptr}];
+        ++state.count;
+        state.time += time;
+        if(initial)
+          initialStates.try_emplace(call.option, *call.state);
+      }
+      const char* option = call.option;
+      calls.pop_back();
+      if(!calls.empty())
+      {
+        Entry& edge = callEdges[{calls.back().option, *calls.back().state, option}];
+        ++edge.count;
+        edge.time += time;
+      }
+    }
+
+    /**
+     * Records a state transition of the option executed last.
+     * @param from The name of the previous state. Null if the option was just (re)activated,
+     *             i.e. the previous state is the initial state.
+     * @param to The name of the new state.
+     */
+    void transition(const char* from, const char* to)
+    {
+      ++transitions[{calls.back().option, from, to}].count;
+    }
+
+    /** Discards all statistics collected so far. */
+    void reset()
+    {
+      transitions.clear();
+      callEdges.clear();
+      states.clear();
+    }
+
+    /**
+     * Writes the statistics in the format read by `bin/createGraphs`.
+     * @param stream The stream that is written to.
+     */
+    void write(std::ostream& stream) const
+    {
+      for(const auto& [names, entry] : merge(transitions, true))
+        stream << "transition " << names << ' ' << entry.count << '\n';
+      for(const auto& [names, entry] : merge(callEdges, false))
+        stream << "call " << names << ' ' << entry.count << ' ' << entry.time / 1000 << '\n';
+      for(const auto& [names, entry] : merge(states, false))
+        stream << "state " << names << ' ' << entry.count << ' ' << entry.time / 1000 << '\n';
+    }
+  };
+}
@@ -0,0 +1,331 @@
+/**
+ * @file IndexedActivationGraph.h
+ *
+ * An activation graph for consumers that process it incrementally, e.g.
+ * user interfaces that only redraw what changed, loggers that only write
+ * differences, or tools that compare frames. In contrast to
+ * `ActivationGraph`, it is not rebuilt in each frame. Instead, each node
+ * keeps its index as long as the same option is called through the same
+ * path, i.e. from the same parent node. The parents are determined from the
+ * actual calls (see `ActivationSink::beginCall`), so this also holds for
+ * options called through `select_option`. The nodes are stored as parallel
+ * arrays that are indexed by these indices. Option and state names are
+ * replaced by IDs. After each frame, bitsets state which nodes were added,
+ * removed, or changed their state, their start times, or their arguments.
+ * Frames that are not recorded because of the filter of the sink leave all
+ * arrays unchanged, i.e. the bitsets still describe the difference between
+ * the last two frames recorded.
+ *
+ * Example:
+ *
+ *     cabsl::IndexedActivationGraph graph;
+ *     Behavior behavior(&graph);
+ *     ...
+ *     for(std::size_t i = 0; i < graph.size(); ++i)
+ *       if(graph.added[i] || graph.changed[i])
+ *         draw(i, graph.getOptionName(i), graph.getStateName(i));
+ *       else if(graph.removed[i])
+ *         erase(i);
+ *
+ * Indices are never reused, so the arrays grow with the number of different
+ * paths through the options that were ever recorded. Options that are not
+ * recorded themselves, e.g. because the filter denies them, still get nodes
+ * if options called by them are recorded, because these nodes are their
+ * parents. Such nodes are never active.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ActivationSink.h"
+
+namespace cabsl
+{
+  class IndexedActivationGraph : public ActivationSink
+  {
+    /** Hashes names without creating strings for looking them up. */
+    struct NameHash
+    {
+      using is_transparent = void;
+      std::size_t operator()(std::string_view name) const {return std::hash<std::string_view>()(name);}
+    };
+
+    /** A table that assigns IDs to names. */
+    struct Names
+    {
+      std::vector<std::string> names; /**< The names indexed by their IDs. */
+      std::unordered_map<std::string, int, NameHash, std::equal_to<>> ids; /**< The IDs of the names. */
+
+      /**
+       * Returns the ID of a name. A new ID is assigned if the name is unknown.
+       * @param name The name.
+       * @return The ID.
+       */
+      int getId(const char* name)
+      {
+        const auto i = ids.find(std::string_view(name));
+        if(i != ids.end())
+          return i->second;
+        names.emplace_back(name);
+        return ids[names.back()] = static_cast<int>(names.size() - 1);
+      }
+    };
+
+    /** An option currently executed. */
+    struct Call
+    {
+      const char* option; /**< The name of the option. */
+      int index; /**< The index of its node. -1 if not determined yet. */
+    };
+
+    Names optionNames; /**< The names of all options recorded so far. */
+    Names stateNames; /**< The names of all states recorded so far. */
+    std::unordered_map<std::uint64_t, int> indices; /**< The index of the first node of each parent index and option ID. */
+    std::vector<int> repetitions; /**< The index of the next node with the same parent and option for each node. -1 if none. */
+    std::vector<Call> calls; /**< The options currently executed, i.e. the actual call stack. */
+    std::vector<bool> used; /**< The nodes that were assigned to a call in the current frame. */
+    std::vector<bool> wasActive; /**< The nodes that were recorded in the previous frame recorded. */
+    std::vector<std::uint64_t> argumentHashes; /**< The hashes of the arguments of each node (FNV-1a). */
+    std::uint64_t argumentHash = 0; /**< The hash of the arguments of the node recorded last so far. */
+    std::size_t argumentCount = 0; /**< The number of entries of `arguments` used in the current frame. */
+    unsigned frameTime = 0; /**< The time of the current frame. */
+    bool started = false; /**< Was anything recorded in the current frame, i.e. were the bitsets reset? */
+    int current = -1; /**< The index of the node recorded last. */
+
+    /**
+     * Returns the index of a node and creates it if it does not exist yet.
+     * An option called more than once from the same parent in the same frame
+     * is represented by a separate node for each repetition.
+     * @param parent The index of the parent node. -1 for a root.
+     * @param optionId The ID of the option.
+     * @return The index of the node.
+     */
+    int getIndex(int parent, int optionId)
+    {
+      int* next = &indices.try_emplace(static_cast<std::uint64_t>(parent + 1) << 32 | static_cast<std::uint32_t>(optionId), -1).first->second;
+      while(*next >= 0 && used[*next])
+        next = &repetitions[*next];
+      if(*next >= 0)
+        return *next;
+      const int index = *next = static_cast<int>(optionIds.size());
+      optionIds.push_back(optionId);
+      stateIds.push_back(-1);
+      depths.push_back(0);
+      parents.push_back(parent);
+      optionStarts.push_back(0);
+      stateStarts.push_back(0);
+      argumentOffsets.push_back(0);
+      argumentCounts.push_back(0);
+      argumentHashes.push_back(0);
+      repetitions.push_back(-1);
+      used.push_back(false);
+      active.push_back(false);
+      wasActive.push_back(false);
+      added.push_back(false);
+      removed.push_back(false);
+      changed.push_back(false);
+      return index;
+    }
+
+    /**
+     * Returns the index of the node of a call. It is determined when it is
+     * needed first, which requires the node of its caller as well.
+     * @param call The position of the call in the call stack.
+     * @return The index of the node.
+     */
+    int resolve(std::size_t call)
+    {
+      if(calls[call].index < 0)
+      {
+        const int parent = call ? resolve(call - 1) : -1;
+        const int index = getIndex(parent, optionNames.getId(calls[call].option));
+        used[index] = true;
+        calls[call].index = index;
+      }
+      return calls[call].index;
+    }
+
+    /** Resets the bitsets when the first option of a frame is recorded. */
+    void start()
+    {
+      if(!started)
+      {
+        started = true;
+        wasActive.swap(active);
+        used.assign(used.size(), false);
+        active.assign(active.size(), false);
+        added.assign(added.size(), false);
+        removed.assign(removed.size(), false);
+        changed.assign(changed.size(), false);
+        order.clear();
+        argumentCount = 0;
+      }
+    }
+
+    /** Marks the node recorded last as changed if its arguments differ from the previous frame. */
+    void finishNode()
+    {
+      if(current >= 0)
+      {
+        if(!added[current] && argumentHashes[current] != argumentHash)
+          changed[current] = true;
+        argumentHashes[current] = argumentHash;
+      }
+    }
+
+  public:
+    std::vector<int> optionIds; /**< The ID of the option of each node (see `getOptionName`). */
+    std::vector<int> stateIds; /**< The ID of the state of each node (see `getStateName`). -1 if not known yet. */
+    std::vector<int> depths; /**< The level of each node in the call hierarchy. */
+    std::vector<int> parents; /**< The index of the parent of each node. -1 for roots. */
+    std::vector<unsigned> optionStarts; /**< When did the option of each node start? */
+    std::vector<unsigned> stateStarts; /**< When did the state of each node start? */
+    std::vector<std::size_t> argumentOffsets; /**< The index of the first argument of each node in `arguments`. */
+    std::vector<std::size_t> argumentCounts; /**< The number of arguments of each node. */
+    std::vector<std::string> arguments; /**< The arguments of all nodes recorded in the current frame as "name = value". Only the entries referenced are valid. */
+    std::vector<int> order; /**< The indices of the nodes recorded in the current frame in the order of the activation graph. */
+    std::vector<bool> active; /**< The nodes recorded in the current frame. */
+    std::vector<bool> added; /**< The nodes recorded in the current frame, but not in the previous one. */
+    std::vector<bool> removed; /**< The nodes recorded in the previous frame, but not in the current one. */
+    std::vector<bool> changed; /**< The nodes recorded in both frames whose state, start times, or arguments differ. */
+
+    /** The constructor requests to be notified about all calls. */
+    IndexedActivationGraph()
+    {
+      callsReported = true;
+    }
+
+    /**
+     * Returns the number of nodes, i.e. the size of all arrays.
+     * @return The number of nodes.
+     */
+    std::size_t size() const {return optionIds.size();}
+
+    /**
+     * Returns the name of the option of a node.
+     * @param index The index of the node.
+     * @return The name of the option.
+     */
+    const std::string& getOptionName(std::size_t index) const {return optionNames.names[optionIds[index]];}
+
+    /**
+     * Returns the name of the state of a node.
+     * @param index The index of the node.
+     * @return The name of the state. Empty if it is not known.
+     */
+    const std::string& getStateName(std::size_t index) const
+    {
+      static const std::string unknown;
+      return stateIds[index] < 0 ? unknown : stateNames.names[stateIds[index]];
+    }
+
+    /**
+     * Starts a new frame. If it is recorded, the nodes of the previous frame
+     * become inactive. Otherwise, this only happens if an option is recorded
+     * after the trigger of the filter fired.
+     * @param frameTime The time of the frame in ms.
+     * @param recorded Is the frame recorded from its beginning?
+     */
+    void beginFrame(unsigned frameTime, bool recorded) override
+    {
+      this->frameTime = frameTime;
+      calls.clear();
+      started = false;
+      current = -1;
+      if(recorded)
+        start();
+    }
+
+    /** Determines which nodes were removed in this frame if it was recorded. */
+    void endFrame() override
+    {
+      if(started)
+      {
+        finishNode();
+        for(std::size_t i = 0; i < size(); ++i)
+          removed[i] = wasActive[i] && !active[i];
+      }
+    }
+
+    /**
+     * Pushes an option onto the call stack. Its node is only determined when
+     * it is needed.
+     * @param option The name of the option.
+     */
+    void beginCall(const char* option) override
+    {
+      calls.push_back({option, -1});
+    }
+
+    /** Pops the option executed last from the call stack. */
+    void endCall() override
+    {
+      if(!calls.empty()) // the sink might have been set during the call
+        calls.pop_back();
+    }
+
+    /**
+     * Activates the node of the option currently executed.
+     * @param option The name of the option.
+     * @param depth The level in the call hierarchy.
+     * @param optionTime How long is the option already active?
+     */
+    void enterOption(const char* option, int depth, int optionTime) override
+    {
+      start();
+      finishNode();
+      if(calls.empty()) // not reported by `beginCall`, e.g. if the sink was set during a frame
+        calls.push_back({option, -1});
+      current = resolve(calls.size() - 1);
+      order.push_back(current);
+      active[current] = true;
+      added[current] = !wasActive[current];
+      const unsigned optionStart = frameTime - static_cast<unsigned>(optionTime);
+      changed[current] = !added[current] && optionStarts[current] != optionStart;
+      depths[current] = depth;
+      optionStarts[current] = optionStart;
+      argumentOffsets[current] = argumentCount;
+      argumentCounts[current] = 0;
+      argumentHash = 14695981039346656037ull;
+    }
+
+    /**
+     * Sets the state of the node activated last.
+     * @param state The name of the state.
+     * @param stateTime How long is the state already active?
+     */
+    void enterState(const char* state, int stateTime) override
+    {
+      const int stateId = *state ? stateNames.getId(state) : -1;
+      const unsigned stateStart = frameTime - static_cast<unsigned>(stateTime);
+      changed[current] = changed[current] || (!added[current] && (stateIds[current] != stateId || stateStarts[current] != stateStart));
+      stateIds[current] = stateId;
+      stateStarts[current] = stateStart;
+    }
+
+    /**
+     * Adds an argument to the node activated last. The string of the entry
+     * used is reused, so it usually does not allocate memory.
+     * @param name The name of the argument.
+     * @param value The value of the argument as text.
+     */
+    void addArgument(const char* name, const std::string& value) override
+    {
+      if(argumentCount == arguments.size())
+        arguments.emplace_back();
+      std::string& argument = arguments[argumentCount++];
+      argument = name;
+      argument += " = ";
+      argument += value;
+      ++argumentCounts[current];
+      for(const char c : argument)
+        argumentHash = (argumentHash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+      argumentHash = (argumentHash ^ 0xff) * 1099511628211ull; // separate arguments
+    }
+  };
+}
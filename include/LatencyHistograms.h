@@ -0,0 +1,328 @@
+/**
+ * @file LatencyHistograms.h
+ *
+ * Histograms of the time a behavior needs per frame, i.e. between
+ * `beginFrame` and `endFrame`, and per root option executed through
+ * `execute`. They allow to report tail latencies such as the 99.9th
+ * percentile instead of just averages.
+ *
+ * The histograms use logarithmic buckets that are linearly subdivided
+ * (similar to HDR histograms), i.e. the relative error of each value is
+ * at most about 3 %, independent of its magnitude. Values between 1 ns and
+ * about 18 minutes can be represented. Each histogram has a constant size.
+ * Recording a value only increments a few atomic counters, so snapshots can
+ * be taken from another thread while the behavior is running.
+ *
+ * Example:
+ *
+ *     cabsl::LatencyHistograms latencyHistograms;
+ *     behavior.setLatencyHistograms(&latencyHistograms);
+ *     ...
+ *     latencyHistograms.writeText(std::cout);
+ *     latencyHistograms.reset();
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace cabsl
+{
+  class LatencyHistogram
+  {
+  public:
+    static constexpr unsigned subBucketBits = 6; /**< Each power of two is divided into 2^(subBucketBits - 1) buckets. */
+    static constexpr unsigned maxBits = 40; /**< Values of 2^maxBits ns and more are put into the last bucket. */
+    static constexpr unsigned numOfBuckets = (1 << subBucketBits) + (maxBits - subBucketBits) * (1 << (subBucketBits - 1)); /**< The number of buckets. */
+
+    /** A copy of the contents of a histogram that can be evaluated. */
+    struct Snapshot
+    {
+      std::uint64_t counts[numOfBuckets] = {0}; /**< The number of values per bucket. */
+      std::uint64_t count = 0; /**< The number of values. */
+      std::uint64_t sum = 0; /**< The sum of all values in ns. */
+      std::uint64_t max = 0; /**< The maximum value in ns. */
+
+      /**
+       * Determines a percentile.
+       * @param percentile The percentile in [0..100].
+       * @return The upper bound of the bucket containing the percentile in ns.
+       */
+      std::uint64_t getPercentile(double percentile) const
+      {
+        const std::uint64_t rank = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(count) + 0.5);
+        std::uint64_t seen = 0;
+        for(unsigned i = 0; i < numOfBuckets; ++i)
+        {
+          seen += counts[i];
+          if(seen >= std::max<std::uint64_t>(rank, 1))
+            return std::min(upperBound(i), max);
+        }
+        return max;
+      }
+
+      /**
+       * Determines the average value.
+       * @return The average in ns.
+       */
+      double getMean() const {return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;}
+    };
+
+  private:
+    std::atomic<std::uint64_t> counts[numOfBuckets]; /**< The number of values per bucket. */
+    std::atomic<std::uint64_t> sum; /**< The sum of all values in ns. */
+    std::atomic<std::uint64_t> max; /**< The maximum value in ns. */
+
+  public:
+    /**
+     * Determines the bucket of a value.
+     * @param value The value in ns.
+     * @return The index of the bucket.
+     */
+    static unsigned bucket(std::uint64_t value)
+    {
+      const unsigned bits = static_cast<unsigned>(std::bit_width(value));
+      if(bits <= subBucketBits)
+        return static_cast<unsigned>(value);
+      else if(bits > maxBits)
+        return numOfBuckets - 1;
+      const unsigned shift = bits - subBucketBits;
+      return (1 << subBucketBits) + (shift - 1) * (1 << (subBucketBits - 1))
+             + static_cast<unsigned>(value >> shift) - (1 << (subBucketBits - 1));
+    }
+
+    /**
+     * Determines the largest value that is still put into a bucket.
+     * @param bucket The index of the bucket.
+     * @return The largest value in ns.
+     */
+    static std::uint64_t upperBound(unsigned bucket)
+    {
+      if(bucket < (1 << subBucketBits))
+        return bucket;
+      const unsigned shift = (bucket - (1 << subBucketBits)) / (1 << (subBucketBits - 1)) + 1;
+      const std::uint64_t top = (bucket - (1 << subBucketBits)) % (1 << (subBucketBits - 1)) + (1 << (subBucketBits - 1));
+      return ((top + 1) << shift) - 1;
+    }
+
+    /** The constructor creates an empty histogram. */
+    LatencyHistogram()
+    {
+      reset();
+    }
+
+    /**
+     * Adds a value.
+     * @param value The value in ns.
+     */
+    void record(std::uint64_t value)
+    {
+      counts[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+      sum.fetch_add(value, std::memory_order_relaxed);
+      std::uint64_t previous = max.load(std::memory_order_relaxed);
+      while(previous < value && !max.compare_exchange_weak(previous, value, std::memory_order_relaxed));
+    }
+
+    /**
+     * Copies the contents of the histogram.
+     * @param reset Also remove all values from this histogram.
+     * @return The contents.
+     */
+    Snapshot snapshot(bool reset = false)
+    {
+      Snapshot snapshot;
+      for(unsigned i = 0; i < numOfBuckets; ++i)
+      {
+        snapshot.counts[i] = reset ? counts[i].exchange(0, std::memory_order_relaxed) : counts[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.counts[i];
+      }
+      snapshot.sum = reset ? sum.exchange(0, std::memory_order_relaxed) : sum.load(std::memory_order_relaxed);
+      snapshot.max = reset ? max.exchange(0, std::memory_order_relaxed) : max.load(std::memory_order_relaxed);
+      return snapshot;
+    }
+
+    /** Removes all values. */
+    void reset()
+    {
+      for(std::atomic<std::uint64_t>& count : counts)
+        count.store(0, std::memory_order_relaxed);
+      sum.store(0, std::memory_order_relaxed);
+      max.store(0, std::memory_order_relaxed);
+    }
+  };
+
+  class LatencyHistograms
+  {
+  public:
+    static constexpr unsigned maxRoots = 16; /**< The maximum number of root options distinguished. Others are ignored. */
+    static constexpr unsigned maxNameLength = 64; /**< The maximum length of root option names. Longer ones are cut. */
+
+  private:
+    /** The histogram of a root option. */
+    struct Root
+    {
+      char name[maxNameLength] = {0}; /**< The name of the option. */
+      LatencyHistogram histogram; /**< The execution times of the option. */
+    };
+
+    LatencyHistogram frames; /**< The times between `beginFrame` and `endFrame`. */
+    Root roots[maxRoots]; /**< The histograms of the root options. */
+    std::atomic<unsigned> numOfRoots = 0; /**< The number of entries used in `roots`. */
+    std::mutex mutex; /**< Serializes adding root options. */
+
+    /**
+     * Writes statistics about a snapshot as text.
+     * @param stream The stream that is written to.
+     * @param name The name of the histogram.
+     * @param snapshot The snapshot.
+     */
+    static void writeText(std::ostream& stream, const char* name, const LatencyHistogram::Snapshot& snapshot)
+    {
+      stream << std::setw(10) << snapshot.count << std::fixed << std::setprecision(3)
+             << std::setw(10) << snapshot.getMean() / 1e3;
+      for(double percentile : {50.0, 90.0, 99.0, 99.9})
+        stream << std::setw(10) << static_cast<double>(snapshot.getPercentile(percentile)) / 1e3;
+      stream << std::setw(10) << static_cast<double>(snapshot.max) / 1e3 << "  " << name << '\n';
+    }
+
+    /**
+     * Writes statistics about a snapshot as a JSON object.
+     * @param stream The stream that is written to.
+     * @param snapshot The snapshot.
+     */
+    static void writeJSON(std::ostream& stream, const LatencyHistogram::Snapshot& snapshot)
+    {
+      stream << "{\"count\":" << snapshot.count << ",\"mean\":" << static_cast<std::uint64_t>(snapshot.getMean())
+             << ",\"p50\":" << snapshot.getPercentile(50.0) << ",\"p90\":" << snapshot.getPercentile(90.0)
+             << ",\"p99\":" << snapshot.getPercentile(99.0) << ",\"p99.9\":" << snapshot.getPercentile(99.9)
+             << ",\"max\":" << snapshot.max << ",\"buckets\":[";
+      bool first = true;
+      for(unsigned i = 0; i < LatencyHistogram::numOfBuckets; ++i)
+        if(snapshot.counts[i])
+        {
+          stream << (first ? "" : ",") << '[' << LatencyHistogram::upperBound(i) << ',' << snapshot.counts[i] << ']';
+          first = false;
+        }
+      stream << "]}";
+    }
+
+  public:
+    /** A copy of all histograms. */
+    struct Snapshot
+    {
+      LatencyHistogram::Snapshot frames; /**< The times between `beginFrame` and `endFrame`. */
+      std::vector<std::pair<std::string, LatencyHistogram::Snapshot>> roots; /**< The times of the root options with their names. */
+    };
+
+    /**
+     * Records the duration of a frame.
+     * @param duration The duration in ns.
+     */
+    void recordFrame(std::uint64_t duration)
+    {
+      frames.record(duration);
+    }
+
+    /**
+     * Records the execution time of a root option.
+     * @param root The name of the option.
+     * @param duration The duration in ns.
+     */
+    void recordRoot(const std::string& root, std::uint64_t duration)
+    {
+      unsigned n = numOfRoots.load(std::memory_order_acquire);
+      for(unsigned i = 0; i < n; ++i)
+        if(root.compare(0, maxNameLength - 1, roots[i].name) == 0)
+        {
+          roots[i].histogram.record(duration);
+          return;
+        }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      n = numOfRoots.load(std::memory_order_relaxed);
+      unsigned i = 0;
+      while(i < n && root.compare(0, maxNameLength - 1, roots[i].name) != 0)
+        ++i;
+      if(i == n)
+      {
+        if(n == maxRoots)
+          return;
+        std::strncpy(roots[i].name, root.c_str(), maxNameLength - 1);
+        numOfRoots.store(n + 1, std::memory_order_release);
+      }
+      roots[i].histogram.record(duration);
+    }
+
+    /**
+     * Copies the contents of all histograms.
+     * @param reset Also remove all values from the histograms.
+     * @return The contents.
+     */
+    Snapshot snapshot(bool reset = false)
+    {
+      Snapshot snapshot;
+      snapshot.frames = frames.snapshot(reset);
+      const unsigned n = numOfRoots.load(std::memory_order_acquire);
+      for(unsigned i = 0; i < n; ++i)
+        snapshot.roots.emplace_back(roots[i].name, roots[i].histogram.snapshot(reset));
+      return snapshot;
+    }
+
+    /** Removes all values from all histograms. */
+    void reset()
+    {
+      frames.reset();
+      const unsigned n = numOfRoots.load(std::memory_order_acquire);
+      for(unsigned i = 0; i < n; ++i)
+        roots[i].histogram.reset();
+    }
+
+    /**
+     * Writes the count, mean, several percentiles, and the maximum of all
+     * histograms as a table. All times are given in µs.
+     * @param stream The stream that is written to.
+     * @param reset Also remove all values from the histograms.
+     */
+    void writeText(std::ostream& stream, bool reset = false)
+    {
+      const Snapshot snapshot = this->snapshot(reset);
+      stream << std::setw(10) << "count" << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90"
+             << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max" << "  (us)\n";
+      writeText(stream, "(frame)", snapshot.frames);
+      for(const auto& [name, root] : snapshot.roots)
+        writeText(stream, name.c_str(), root);
+    }
+
+    /**
+     * Writes all histograms as a JSON object. All times are given in ns. Only
+     * buckets that are not empty are written as pairs of their upper bound and
+     * their count.
+     * @param stream The stream that is written to.
+     * @param reset Also remove all values from the histograms.
+     */
+    void writeJSON(std::ostream& stream, bool reset = false)
+    {
+      const Snapshot snapshot = this->snapshot(reset);
+      stream << "{\"frame\":";
+      writeJSON(stream, snapshot.frames);
+      stream << ",\"roots\":{";
+      bool first = true;
+      for(const auto& [name, root] : snapshot.roots)
+      {
+        stream << (first ? "\"" : ",\"") << name << "\":";
+        writeJSON(stream, root);
+        first = false;
+      }
+      stream << "}}\n";
+    }
+  };
+}
@@ -0,0 +1,336 @@
+/**
+ * @file ModuleLoader.h
+ *
+ * A class that loads, replaces, and unloads modules, i.e. shared libraries
+ * that contain implementations of options. This allows to change the code
+ * of options without restarting the program that executes the behavior.
+ *
+ * Only options that are declared in the behavior class and implemented in
+ * a separate file can be replaced (see "Defining Options Inline or
+ * Separately" in the Readme). A module is built from such implementation
+ * files, which must be compiled with `CABSL_MODULE` defined. The program
+ * still contains its own implementations, which are executed as long as no
+ * module replaces them. The program must export its symbols (`-rdynamic`)
+ * and the module should hide its own ones (`-fvisibility=hidden`), so that
+ * the module does not use the program's copies of its code and the
+ * program's options called by the module are still found. With *g++*,
+ * `-fno-gnu-unique` should be used for the module, because otherwise, it
+ * might not be possible to unload it.
+ *
+ * Requests to load or unload modules can be made from any thread. They are
+ * only executed by `update`, which must be called at a frame boundary,
+ * i.e. while none of the behavior instances executes a frame. The contexts
+ * of the options replaced are kept, i.e. they continue in the state with
+ * the same name if the new implementation has one. Otherwise, they restart
+ * in their initial state. Their variables and definitions are recreated,
+ * because their types belong to the implementation replaced.
+ *
+ * Example:
+ *
+ *     cabsl::ModuleLoader<Behavior> loader({&behavior});
+ *     loader.load("options.so");
+ *     for(unsigned time = 0;; time += 10)
+ *     {
+ *       if(!loader.update())
+ *         std::cerr << loader.getError() << "\n";
+ *       behavior.beginFrame(time);
+ *       behavior.execute("root");
+ *       behavior.endFrame();
+ *     }
+ */
+
+#pragma once
+
+#include <dlfcn.h>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Cabsl.h"
+
+namespace cabsl
+{
+  template<typename CabslBehavior> class ModuleLoader
+  {
+    using Base = typename CabslBehavior::Cabsl; /**< The base class of the behavior. */
+    using OptionContext = typename Base::OptionContext;
+    using OptionImplementation = typename Base::OptionImplementation;
+    using OptionInfos = typename Base::OptionInfos;
+    using StateDescriptor = typename Base::StateDescriptor;
+
+    /** A module loaded. */
+    struct Module
+    {
+      void* handle; /**< The handle of the shared library. */
+      const ModuleInfo* info; /**< The options and states the module implements. */
+    };
+
+    /** An option the implementation of which was removed. */
+    struct Detached
+    {
+      size_t offsetOfContext; /**< The memory offset of the context within the behavior class. */
+      std::vector<std::string> stateNames; /**< The names of the current states in all behaviors. Empty for the initial state. */
+    };
+
+    /** A request to load or unload a module. */
+    struct Request
+    {
+      std::string path; /**< The path to the module. */
+      bool load; /**< Load the module? Otherwise, unload it. */
+    };
+
+    std::vector<CabslBehavior*> behaviors; /**< The instances of the behavior whose contexts are updated. */
+    std::unordered_map<std::string, Module> modules; /**< The modules loaded, indexed by their paths. */
+    std::unordered_map<std::string, std::string> owners; /**< The paths of the modules that implement options, indexed by the names of the options. */
+    std::vector<Request> requests; /**< The requests not executed yet. */
+    std::mutex mutex; /**< Protects `requests`. */
+    std::string error; /**< The last error that occurred. */
+
+    /**
+     * Returns the context of an option in a behavior.
+     * @param behavior The behavior.
+     * @param offsetOfContext The memory offset of the context within the behavior class.
+     * @return The context.
+     */
+    static OptionContext& getContext(CabslBehavior* behavior, size_t offsetOfContext)
+    {
+      return *reinterpret_cast<OptionContext*>(reinterpret_cast<char*>(behavior) + offsetOfContext);
+    }
+
+    /**
+     * Checks whether a state belongs to an option.
+     * @param state The state.
+     * @param option The name of the option.
+     * @return Does it belong to the option?
+     */
+    static bool belongsTo(const StateDescriptor* state, const std::string& option)
+    {
+      return option == state->option + (*state->option == '_' ? 1 : 0);
+    }
+
+    /**
+     * Returns the states of the implementations linked into the program.
+     * @return The states.
+     */
+    static std::vector<const StateDescriptor*> getProgramStates()
+    {
+      return OptionInfos::states ? *OptionInfos::states : std::vector<const StateDescriptor*>();
+    }
+
+    /**
+     * Removes the current implementation of an option from all behaviors. The
+     * variables and definitions are destroyed, because their types belong to that
+     * implementation. The names of the current states are remembered.
+     * @param option The option.
+     * @param states The states of the current implementation.
+     * @return The option detached.
+     */
+    Detached detach(const OptionImplementation& option, const std::vector<const StateDescriptor*>& states)
+    {
+      Detached detached{option.offsetOfContext, {}};
+      for(CabslBehavior* behavior : behaviors)
+      {
+        OptionContext& context = getContext(behavior, option.offsetOfContext);
+        std::string stateName;
+        if(context.state)
+          for(const StateDescriptor* state : states)
+            if(state->id == context.state && belongsTo(state, option.name))
+              stateName = state->name;
+        detached.stateNames.emplace_back(stateName);
+        context.vars.reset();
+        context.defs.reset();
+        context.stateName = nullptr;
+      }
+      return detached;
+    }
+
+    /**
+     * Continues an option with a new implementation in all behaviors. It stays in
+     * the states with the same names. If the new implementation does not have such a
+     * state, the option restarts in its initial state.
+     * @param option The name of the option.
+     * @param detached The option as detached from the previous implementation.
+     * @param states The states of the new implementation.
+     */
+    void attach(const std::string& option, const Detached& detached, const std::vector<const StateDescriptor*>& states)
+    {
+      for(size_t i = 0; i < behaviors.size(); ++i)
+      {
+        OptionContext& context = getContext(behaviors[i], detached.offsetOfContext);
+        if(context.state)
+        {
+          const StateDescriptor* found = nullptr;
+          for(const StateDescriptor* state : states)
+            if(state->name == detached.stateNames[i] && state->stateType != OptionContext::initialState && belongsTo(state, option))
+              found = state;
+          if(found)
+          {
+            context.state = found->id;
+            context.stateType = found->stateType;
+          }
+          else
+          {
+            context.lastFrame = static_cast<unsigned>(-1);
+            context.lastSelectFrame = static_cast<unsigned>(-1);
+          }
+        }
+      }
+    }
+
+    /**
+     * Unloads a module. Its options are detached.
+     * @param module The module.
+     * @param detached The options detached are added here.
+     */
+    void close(const Module& module, std::unordered_map<std::string, Detached>& detached)
+    {
+      std::vector<const StateDescriptor*> states;
+      for(const void* state : module.info->states)
+        states.push_back(static_cast<const StateDescriptor*>(state));
+      for(const void* entry : module.info->options)
+      {
+        const OptionImplementation& option = *static_cast<const OptionImplementation*>(entry);
+        OptionInfos::implementation(option.name).store(nullptr, std::memory_order_release);
+        detached[option.name] = detach(option, states);
+        owners.erase(option.name);
+      }
+      dlclose(module.handle);
+    }
+
+    /**
+     * Loads a module and replaces the implementations of the options it contains.
+     * @param path The path to the module.
+     * @param detached Options that were already detached from their previous implementations.
+     *                 The ones replaced by the module are removed.
+     * @return Was the module loaded?
+     */
+    bool open(const std::string& path, std::unordered_map<std::string, Detached>& detached)
+    {
+      void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+      if(!handle)
+      {
+        const char* message = dlerror();
+        error = message ? message : "cannot load " + path;
+        return false;
+      }
+      const ModuleInfo* (*entry)() = reinterpret_cast<const ModuleInfo* (*)()>(dlsym(handle, "cabslModule"));
+      if(!entry)
+      {
+        error = path + " is not a CABSL module";
+        dlclose(handle);
+        return false;
+      }
+      const ModuleInfo* info = entry();
+      for(const void* option : info->options)
+      {
+        const auto owner = owners.find(static_cast<const OptionImplementation*>(option)->name);
+        if(owner != owners.end())
+        {
+          error = path + ": option " + owner->first + " is already implemented by " + owner->second;
+          dlclose(handle);
+          return false;
+        }
+      }
+
+      if(info->connect)
+        info->connect(OptionInfos::optionsByName);
+      std::vector<const StateDescriptor*> states;
+      for(const void* state : info->states)
+        states.push_back(static_cast<const StateDescriptor*>(state));
+      const std::vector<const StateDescriptor*> programStates = getProgramStates();
+      for(const void* entry : info->options)
+      {
+        const OptionImplementation& option = *static_cast<const OptionImplementation*>(entry);
+        auto previous = detached.find(option.name);
+        if(previous == detached.end())
+          previous = detached.emplace(option.name, detach(option, programStates)).first;
+        attach(option.name, previous->second, states);
+        detached.erase(previous);
+        OptionInfos::implementation(option.name).store(&option, std::memory_order_release);
+        owners[option.name] = path;
+      }
+      modules[path] = {handle, info};
+      return true;
+    }
+
+  public:
+    /**
+     * Constructor.
+     * @param behaviors The instances of the behavior whose options can be replaced.
+     */
+    ModuleLoader(const std::vector<CabslBehavior*>& behaviors) :
+      behaviors(behaviors)
+    {}
+
+    /** The destructor unloads all modules. It must be called at a frame boundary. */
+    ~ModuleLoader()
+    {
+      for(const auto& [path, module] : modules)
+        unload(path);
+      update();
+    }
+
+    /**
+     * Requests to load a module. If it is already loaded, it is replaced by the
+     * current version of the file. Can be called from any thread.
+     * @param path The path to the module.
+     */
+    void load(const std::string& path)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      requests.push_back({path, true});
+    }
+
+    /**
+     * Requests to unload a module. Can be called from any thread.
+     * @param path The path to the module.
+     */
+    void unload(const std::string& path)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      requests.push_back({path, false});
+    }
+
+    /**
+     * Executes all pending requests. Must be called at a frame boundary, i.e. while
+     * none of the behaviors executes a frame.
+     * @return Were all requests executed successfully? Otherwise, `getError` describes
+     *         the last problem.
+     */
+    bool update()
+    {
+      std::vector<Request> requests;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.swap(this->requests);
+      }
+
+      bool success = true;
+      for(const Request& request : requests)
+      {
+        std::unordered_map<std::string, Detached> detached;
+        const auto module = modules.find(request.path);
+        if(module != modules.end())
+        {
+          close(module->second, detached);
+          modules.erase(module);
+        }
+        if(request.load && !open(request.path, detached))
+          success = false;
+
+        // Options no longer replaced continue with the implementations of the program.
+        const std::vector<const StateDescriptor*> programStates = getProgramStates();
+        for(const auto& [name, option] : detached)
+          attach(name, option, programStates);
+      }
+      return success;
+    }
+
+    /**
+     * Returns the description of the last error.
+     * @return The error message.
+     */
+    const std::string& getError() const {return error;}
+  };
+}
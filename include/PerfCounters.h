@@ -0,0 +1,271 @@
+/**
+ * @file PerfCounters.h
+ *
+ * Measures hardware performance counters around the execution of each option
+ * and attributes the differences to options and the states they ended in.
+ * The counters are CPU cycles, instructions, cache misses, and branch
+ * misses. They are only counted for the thread that created the object and
+ * only in user space. For each option/state pair, the counts including and
+ * excluding the sub-options called are accumulated. A report lists the
+ * pairs that caused the most cycles, cache misses, or branch misses.
+ *
+ * The counters are read through the Linux system call `perf_event_open`.
+ * Reading them requires a system call per option call and per option exit,
+ * so this is an instrumentation mode for analysis rather than for normal
+ * operation. If the counters cannot be opened (e.g. on other operating
+ * systems, in virtual machines without access to the performance monitoring
+ * unit, or because of `/proc/sys/kernel/perf_event_paranoid`),
+ * `isAvailable()` returns `false` and nothing is measured.
+ *
+ * Example:
+ *
+ *     cabsl::PerfCounters perfCounters;
+ *     if(perfCounters.isAvailable())
+ *       behavior.setPerfCounters(&perfCounters);
+ *     ...
+ *     perfCounters.writeReport(std::cout);
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cabsl
+{
+  class PerfCounters
+  {
+  public:
+    /** The counters measured. */
+    enum Counter
+    {
+      cycles,
+      instructions,
+      cacheMisses,
+      branchMisses,
+      numOfCounters
+    };
+
+    /** The values of all counters. */
+    struct Values
+    {
+      std::uint64_t values[numOfCounters] = {0}; /**< The values, indexed by `Counter`. */
+
+      std::uint64_t& operator[](int counter) {return values[counter];}
+      std::uint64_t operator[](int counter) const {return values[counter];}
+    };
+
+  private:
+    /** The statistics collected for an option/state pair. */
+    struct Entry
+    {
+      std::uint64_t count = 0; /**< How often was the option executed ending in this state? */
+      Values inclusive; /**< The counts including the sub-options called. */
+      Values exclusive; /**< The counts excluding the sub-options called. */
+    };
+
+    /** Information about an option currently executed. */
+    struct Call
+    {
+      Values start; /**< The counter values when the option started. */
+      Values children; /**< The counts of the sub-options called so far. */
+    };
+
+    int fds[numOfCounters]; /**< The file descriptors of the counters. The first one is the group leader. */
+    bool available = false; /**< Could all counters be opened? */
+    std::vector<Call> calls; /**< The options currently executed. */
+    std::map<std::pair<const char*, const char*>, Entry> entries; /**< The statistics, indexed by the addresses of the option and state names. */
+
+    /**
+     * Reads the current values of all counters.
+     * @param values The values read are written here.
+     */
+    void read(Values& values) const
+    {
+#ifdef __linux__
+      struct
+      {
+        std::uint64_t numOfValues;
+        std::uint64_t values[numOfCounters];
+      } buffer;
+      if(::read(fds[0], &buffer, sizeof(buffer)) == static_cast<ssize_t>(sizeof(buffer)))
+        for(int i = 0; i < numOfCounters; ++i)
+          values[i] = buffer.values[i];
+#else
+      static_cast<void>(values);
+#endif
+    }
+
+    /**
+     * Writes a table of the entries that are the worst with respect to a certain counter.
+     * @param stream The stream that is written to.
+     * @param entries The entries with their names.
+     * @param counter The counter the entries are sorted by.
+     * @param top The maximum number of entries listed.
+     */
+    static void writeTable(std::ostream& stream, std::vector<std::pair<std::string, Entry>>& entries, Counter counter, std::size_t top)
+    {
+      static const char* names[] = {"cycles", "instructions", "cache misses", "branch misses"};
+      std::sort(entries.begin(), entries.end(), [counter](const auto& a, const auto& b) {return a.second.exclusive[counter] > b.second.exclusive[counter];});
+      stream << "top " << std::min(top, entries.size()) << " by " << names[counter] << " (excluding sub-options):\n"
+             << std::setw(10) << "calls" << std::setw(14) << "cycles" << std::setw(14) << "instructions" << std::setw(6) << "IPC"
+             << std::setw(14) << "cache misses" << std::setw(14) << "branch misses" << "  option/state\n";
+      for(std::size_t i = 0; i < top && i < entries.size(); ++i)
+      {
+        const Entry& entry = entries[i].second;
+        stream << std::setw(10) << entry.count << std::setw(14) << entry.exclusive[cycles] << std::setw(14) << entry.exclusive[instructions]
+               << std::setw(6) << std::fixed << std::setprecision(2)
+               << (entry.exclusive[cycles] ? static_cast<double>(entry.exclusive[instructions]) / static_cast<double>(entry.exclusive[cycles]) : 0.)
+               << std::setw(14) << entry.exclusive[cacheMisses] << std::setw(14) << entry.exclusive[branchMisses]
+               << "  " << entries[i].first << '\n';
+      }
+      stream << '\n';
+    }
+
+  public:
+    /** The constructor opens the counters for the calling thread. */
+    PerfCounters()
+    {
+      std::fill(fds, fds + numOfCounters, -1);
+#ifdef __linux__
+      static const std::uint64_t configs[numOfCounters] =
+      {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+      };
+      available = true;
+      for(int i = 0; i < numOfCounters && available; ++i)
+      {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = i == 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        fds[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, fds[0], 0));
+        available = fds[i] != -1;
+      }
+      if(available)
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+      calls.reserve(32);
+    }
+
+    /** The destructor closes the counters. */
+    ~PerfCounters()
+    {
+#ifdef __linux__
+      for(int fd : fds)
+        if(fd != -1)
+          close(fd);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * Could the counters be opened?
+     * @return Are measurements possible?
+     */
+    bool isAvailable() const {return available;}
+
+    /** Records that an option begins. */
+    void enter()
+    {
+      calls.emplace_back();
+      read(calls.back().start);
+    }
+
+    /**
+     * Records that the option entered last ends.
+     * @param option The name of the option.
+     * @param state The name of the state the option ended in. Can be null.
+     */
+    void exit(const char* option, const char* state)
+    {
+      Values end;
+      read(end);
+      const Call& call = calls.back();
+      Entry& entry = entries[{option, state}];
+      ++entry.count;
+      Values delta;
+      for(int i = 0; i < numOfCounters; ++i)
+      {
+        delta[i] = end[i] - call.start[i];
+        entry.inclusive[i] += delta[i];
+        entry.exclusive[i] += delta[i] - std::min(delta[i], call.children[i]);
+      }
+      calls.pop_back();
+      if(!calls.empty())
+        for(int i = 0; i < numOfCounters; ++i)
+          calls.back().children[i] += delta[i];
+    }
+
+    /** Discards all statistics collected so far. */
+    void reset()
+    {
+      entries.clear();
+    }
+
+    /**
+     * Returns the statistics for all option/state pairs. Pairs with the same
+     * names are merged.
+     * @param includeChildren Return the counts including sub-options instead of excluding them.
+     * @return The counts indexed by "option/state".
+     */
+    std::map<std::string, Values> getValues(bool includeChildren = false) const
+    {
+      std::map<std::string, Values> result;
+      for(const auto& [names, entry] : entries)
+      {
+        Values& values = result[std::string(names.first) + '/' + (names.second ? names.second : "")];
+        for(int i = 0; i < numOfCounters; ++i)
+          values[i] += includeChildren ? entry.inclusive[i] : entry.exclusive[i];
+      }
+      return result;
+    }
+
+    /**
+     * Writes a report listing the option/state pairs that caused the most
+     * cycles, cache misses, and branch misses.
+     * @param stream The stream that is written to.
+     * @param top The maximum number of pairs listed per table.
+     */
+    void writeReport(std::ostream& stream, std::size_t top = 10) const
+    {
+      std::map<std::string, Entry> merged;
+      for(const auto& [names, entry] : entries)
+      {
+        Entry& sum = merged[std::string(names.first) + '/' + (names.second ? names.second : "")];
+        sum.count += entry.count;
+        for(int i = 0; i < numOfCounters; ++i)
+        {
+          sum.inclusive[i] += entry.inclusive[i];
+          sum.exclusive[i] += entry.exclusive[i];
+        }
+      }
+      std::vector<std::pair<std::string, Entry>> sorted(merged.begin(), merged.end());
+      writeTable(stream, sorted, cycles, top);
+      writeTable(stream, sorted, cacheMisses, top);
+      writeTable(stream, sorted, branchMisses, top);
+    }
+  };
+}
@@ -0,0 +1,39 @@
+/**
+ * @file Probes.h
+ *
+ * Statically defined tracepoints (USDT probes) for tools such as `perf`,
+ * `bpftrace`, and SystemTap. CABSL emits the following probes of the
+ * provider `cabsl`:
+ *
+ * - `option_entry` when an option starts its execution,
+ * - `option_exit` when an option ends its execution, and
+ * - `state_transition` when an option switches to another state.
+ *
+ * All probes have the same four arguments: the name of the option, the name
+ * of the current (or new) state, the depth of the option in the call
+ * hierarchy, and the current frame time. The name of the state can be null
+ * if it is not known yet. For instance, all state transitions of the example
+ * can be listed with:
+ *
+ *     sudo bpftrace -e 'usdt:./soccer:cabsl:state_transition
+ *       { printf("%u %s -> %s\n", arg3, str(arg0), str(arg1)); }'
+ *
+ * The probes are based on the header `sys/sdt.h` of SystemTap, which only
+ * inserts a `nop` instruction per probe and a note describing where to find
+ * its arguments. If the header is not available or `CABSL_NO_PROBES` is
+ * defined, no code is generated at all.
+ */
+
+#pragma once
+
+#if !defined CABSL_NO_PROBES && defined __linux__ && defined __has_include
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define _CABSL_PROBE(name, option, state, depth, time) STAP_PROBE4(cabsl, name, option, state, depth, time)
+#endif
+#endif
+
+// The arguments are not evaluated, but they count as used.
+#ifndef _CABSL_PROBE
+#define _CABSL_PROBE(name, option, state, depth, time) static_cast<void>(sizeof(option) + sizeof(state) + sizeof(depth) + sizeof(time))
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file Profiler.h
+ *
+ * A profiler that aggregates how often options are executed and how much
+ * time they take over long periods. The statistics are collected separately
+ * for each call path through the option hierarchy, e.g.
+ * `play_soccer/striker/go_to/go_dir`. They are stored in a tree, the nodes
+ * of which only contain IDs of the option names, counters, and times.
+ * Therefore, the overhead is mainly the time required to read the clock
+ * twice per option executed.
+ *
+ * The statistics can be written as folded stacks, which are accepted by
+ * flame graph tools such as `flamegraph.pl` or https://www.speedscope.app,
+ * and as a text report sorted by inclusive time. If file names are passed
+ * to the constructor, both are written when the profiler is destroyed.
+ *
+ * Example:
+ *
+ *     cabsl::Profiler profiler("profile.txt", "profile.folded");
+ *     behavior.setProfiler(&profiler);
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cabsl
+{
+  class Profiler
+  {
+    /** A node of the call path tree. */
+    struct Node
+    {
+      unsigned option; /**< The ID of the name of the option. */
+      unsigned parent; /**< The index of the parent node. */
+      unsigned firstChild = 0; /**< The index of the first child node. 0 if there is none. */
+      unsigned nextSibling = 0; /**< The index of the next sibling node. 0 if there is none. */
+      std::uint64_t count = 0; /**< How often was this call path executed? */
+      std::uint64_t inclusive = 0; /**< The time spent in this call path including sub-options in ns. */
+    };
+
+    std::vector<Node> nodes; /**< All nodes. The first one is the root of all root options. */
+    std::vector<std::string> names; /**< The names of all options, indexed by their IDs. */
+    std::unordered_map<const char*, unsigned> idsByAddress; /**< The IDs of option names, indexed by the addresses of the names. */
+    std::unordered_map<std::string, unsigned> idsByName; /**< The IDs of option names, indexed by the names. */
+    std::vector<std::chrono::steady_clock::time_point> starts; /**< The start times of all options currently executed. */
+    unsigned current = 0; /**< The index of the node of the option currently executed. */
+    unsigned frames = 0; /**< The number of frames profiled. */
+    std::string reportFilename; /**< The file the report is written to when destroyed. Ignored if empty. */
+    std::string foldedFilename; /**< The file the folded stacks are written to when destroyed. Ignored if empty. */
+
+    /**
+     * Returns the ID of an option name. Names are registered when they are seen
+     * for the first time.
+     * @param name The name.
+     * @return The ID of the name.
+     */
+    unsigned intern(const char* name)
+    {
+      auto entry = idsByAddress.find(name);
+      if(entry == idsByAddress.end())
+      {
+        auto [byName, added] = idsByName.emplace(name, static_cast<unsigned>(names.size()));
+        if(added)
+          names.emplace_back(name);
+        entry = idsByAddress.emplace(name, byName->second).first;
+      }
+      return entry->second;
+    }
+
+    /**
+     * Determines the time spent in a node without its children.
+     * @param index The index of the node.
+     * @return The time in ns.
+     */
+    std::uint64_t exclusive(unsigned index) const
+    {
+      std::uint64_t time = nodes[index].inclusive;
+      for(unsigned child = nodes[index].firstChild; child; child = nodes[child].nextSibling)
+        time -= nodes[child].inclusive;
+      return time;
+    }
+
+    /**
+     * Determines the call path of a node.
+     * @param index The index of the node.
+     * @param separator The separator used between the names of options.
+     * @return The call path.
+     */
+    std::string path(unsigned index, char separator) const
+    {
+      std::string path = names[nodes[index].option];
+      for(index = nodes[index].parent; index; index = nodes[index].parent)
+        path = names[nodes[index].option] + separator + path;
+      return path;
+    }
+
+  public:
+    /**
+     * Constructor.
+     * @param reportFilename The file the report is written to when the profiler is destroyed.
+     *                       Nothing is written if it is empty.
+     * @param foldedFilename The file the folded stacks are written to when the profiler is
+     *                       destroyed. Nothing is written if it is empty.
+     */
+    Profiler(const std::string& reportFilename = "", const std::string& foldedFilename = "") :
+      reportFilename(reportFilename), foldedFilename(foldedFilename)
+    {
+      nodes.push_back({0, 0});
+      names.emplace_back("");
+      nodes.reserve(256);
+      starts.reserve(32);
+    }
+
+    /** The destructor writes the files that were specified in the constructor. */
+    ~Profiler()
+    {
+      if(!reportFilename.empty())
+      {
+        std::ofstream stream(reportFilename);
+        writeReport(stream);
+      }
+      if(!foldedFilename.empty())
+      {
+        std::ofstream stream(foldedFilename);
+        writeFoldedStacks(stream);
+      }
+    }
+
+    /**
+     * Records that an option begins.
+     * @param option The name of the option.
+     */
+    void enter(const char* option)
+    {
+      const unsigned id = intern(option);
+      unsigned child = nodes[current].firstChild;
+      while(child && nodes[child].option != id)
+        child = nodes[child].nextSibling;
+      if(!child)
+      {
+        child = static_cast<unsigned>(nodes.size());
+        nodes.push_back({id, current, 0, nodes[current].firstChild});
+        nodes[current].firstChild = child;
+      }
+      current = child;
+      starts.push_back(std::chrono::steady_clock::now());
+    }
+
+    /** Records that the option entered last ends. */
+    void exit()
+    {
+      Node& node = nodes[current];
+      node.inclusive += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - starts.back()).count());
+      ++node.count;
+      starts.pop_back();
+      current = node.parent;
+    }
+
+    /** Called at the end of each frame. */
+    void endFrame()
+    {
+      ++frames;
+    }
+
+    /** Discards all statistics collected so far. */
+    void reset()
+    {
+      for(Node& node : nodes)
+      {
+        node.count = 0;
+        node.inclusive = 0;
+      }
+      frames = 0;
+    }
+
+    /**
+     * Writes the statistics as folded stacks, i.e. one line per call path with the
+     * names of the options separated by semicolons, followed by the exclusive time
+     * in µs.
+     * @param stream The stream that is written to.
+     */
+    void writeFoldedStacks(std::ostream& stream) const
+    {
+      for(unsigned index = 1; index < nodes.size(); ++index)
+        if(nodes[index].count)
+          stream << path(index, ';') << ' ' << exclusive(index) / 1000 << '\n';
+    }
+
+    /**
+     * Writes a report with one line per call path sorted by inclusive time.
+     * @param stream The stream that is written to.
+     */
+    void writeReport(std::ostream& stream) const
+    {
+      std::vector<unsigned> indices;
+      for(unsigned index = 1; index < nodes.size(); ++index)
+        if(nodes[index].count)
+          indices.push_back(index);
+      std::sort(indices.begin(), indices.end(), [this](unsigned a, unsigned b) {return nodes[a].inclusive > nodes[b].inclusive;});
+
+      stream << "frames: " << frames << "\n\n"
+             << std::setw(12) << "calls" << std::setw(14) << "incl. ms" << std::setw(14) << "excl. ms"
+             << std::setw(12) << "avg. us" << "  call path\n";
+      stream << std::fixed << std::setprecision(3);
+      for(unsigned index : indices)
+      {
+        const Node& node = nodes[index];
+        stream << std::setw(12) << node.count
+               << std::setw(14) << static_cast<double>(node.inclusive) / 1e6
+               << std::setw(14) << static_cast<double>(exclusive(index)) / 1e6
+               << std::setw(12) << static_cast<double>(node.inclusive) / 1e3 / static_cast<double>(node.count)
+               << "  " << path(index, '/') << '\n';
+      }
+    }
+  };
+}
@@ -0,0 +1,191 @@
+/**
+ * @file Recorder.h
+ *
+ * A recorder that writes fixed-size records, e.g. the inputs and outputs of
+ * each behavior step, to a binary log, and a class that reads such a log
+ * back for replaying it. The records are collected in a buffer that is
+ * handed over to a background thread when it is full, which writes it to
+ * the file. Therefore, recording a record only copies it. A record must be
+ * trivially copyable. Its size is stored in the header of the log, so a log
+ * written with a different record layout is rejected when it is read.
+ *
+ * Example:
+ *
+ *     cabsl::Recorder<Frame> recorder("game.log");
+ *     recorder.record(frame);
+ *     ...
+ *     cabsl::Recording<Frame> recording("game.log");
+ *     for(const Frame& frame : recording.getRecords())
+ *       ...
+ *
+ * The file is completed when the recorder is destroyed.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace cabsl
+{
+  /** The beginning of a log. */
+  struct RecordingHeader
+  {
+    char magic[8]; /**< Identifies the file format. */
+    std::uint32_t recordSize; /**< The size of each record in bytes. */
+  };
+
+  /** The identifier at the beginning of each log. */
+  inline constexpr char recordingMagic[8] = {'C', 'A', 'B', 'S', 'L', 'L', 'O', 'G'};
+
+  template<typename Record> class Recorder
+  {
+    static_assert(std::is_trivially_copyable<Record>::value, "Records are written as they are");
+
+    std::ofstream stream; /**< The file the log is written to. */
+    std::size_t capacity; /**< The number of records after which the buffer is handed over. */
+    std::vector<Record> records; /**< The records recorded since the last hand-over. */
+    std::mutex mutex; /**< Protects all members below. */
+    std::condition_variable condition; /**< Wakes up the writer thread and threads waiting for it. */
+    std::vector<Record> queue; /**< Records not written yet. */
+    bool stop = false; /**< Should the writer thread terminate? */
+    std::thread writer; /**< The thread writing the records. Started last. */
+
+    /** The main loop of the writer thread. */
+    void run()
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while(!stop || !queue.empty())
+      {
+        condition.wait(lock, [this] {return stop || !queue.empty();});
+        std::vector<Record> records;
+        records.swap(queue);
+        lock.unlock();
+        stream.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(Record)));
+        stream.flush();
+        lock.lock();
+        if(queue.empty())
+        {
+          records.clear();
+          queue.swap(records); // Return the memory for the next hand-over.
+        }
+        condition.notify_all();
+      }
+    }
+
+  public:
+    /**
+     * Constructor.
+     * @param path The path to the log file.
+     * @param capacity The number of records after which they are handed over to
+     *                 the writer thread.
+     */
+    Recorder(const std::string& path, std::size_t capacity = 4096) :
+      stream(path, std::ios::binary), capacity(capacity)
+    {
+      RecordingHeader header;
+      std::memcpy(header.magic, recordingMagic, sizeof(header.magic));
+      header.recordSize = static_cast<std::uint32_t>(sizeof(Record));
+      stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      records.reserve(capacity);
+      writer = std::thread(&Recorder::run, this);
+    }
+
+    /** The destructor writes all remaining records and closes the file. */
+    ~Recorder()
+    {
+      flush();
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      condition.notify_all();
+      writer.join();
+    }
+
+    /**
+     * Was the file opened successfully and were all records written so far?
+     * @return Is the recorder in a good state?
+     */
+    bool good() const {return stream.good();}
+
+    /**
+     * Records a record. Must always be called from the same thread.
+     * @param record The record.
+     */
+    void record(const Record& record)
+    {
+      records.push_back(record);
+      if(records.size() >= capacity)
+        flush();
+    }
+
+    /**
+     * Hands over all records to the writer thread. If it is still writing the
+     * previous ones, the caller waits.
+     */
+    void flush()
+    {
+      if(records.empty())
+        return;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] {return queue.empty();});
+        queue.swap(records);
+      }
+      condition.notify_all();
+      records.reserve(capacity);
+    }
+  };
+
+  template<typename Record> class Recording
+  {
+    std::vector<Record> records; /**< The records read. */
+    std::string error; /**< The description of the error that occurred while reading. */
+
+  public:
+    /**
+     * Reads a log.
+     * @param path The path to the log file.
+     */
+    Recording(const std::string& path)
+    {
+      std::ifstream stream(path, std::ios::binary);
+      RecordingHeader header;
+      if(!stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        error = "cannot read " + path;
+      else if(std::memcmp(header.magic, recordingMagic, sizeof(header.magic)))
+        error = path + " is not a log";
+      else if(header.recordSize != sizeof(Record))
+        error = path + " contains records of " + std::to_string(header.recordSize) + " instead of "
+                + std::to_string(sizeof(Record)) + " bytes";
+      else
+      {
+        const std::streamoff start = stream.tellg();
+        stream.seekg(0, std::ios::end);
+        records.resize(static_cast<std::size_t>(stream.tellg() - start) / sizeof(Record));
+        stream.seekg(start);
+        stream.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(Record)));
+      }
+    }
+
+    /**
+     * Returns the records. A record that was only written partially is skipped.
+     * @return The records in the sequence they were recorded.
+     */
+    const std::vector<Record>& getRecords() const {return records;}
+
+    /**
+     * Returns the description of the error that occurred while reading.
+     * @return The error message. Empty if the log was read successfully.
+     */
+    const std::string& getError() const {return error;}
+  };
+}
@@ -0,0 +1,300 @@
+/**
+ * @file Tracer.h
+ *
+ * A tracer that records the execution of options as a timeline. Each
+ * behavior writes begin and end events of the options it executes as well
+ * as the state transitions it performs into its own buffer. Option and state
+ * names are only stored as IDs in these buffers. The buffers are handed over
+ * to a background thread from time to time, which writes them to a file in
+ * the Chrome trace event format. Such a file can be opened in a trace viewer
+ * such as `chrome://tracing` or https://ui.perfetto.dev, showing the nested
+ * option calls and their durations.
+ *
+ * Example:
+ *
+ *     cabsl::Tracer tracer("trace.json");
+ *     cabsl::Tracer::Buffer buffer(tracer, "player 1");
+ *     behavior.setTraceBuffer(&buffer);
+ *
+ * The file is completed when the tracer is destroyed. All buffers must be
+ * destroyed before that.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cabsl
+{
+  class Tracer
+  {
+    /** A single entry in the timeline. */
+    struct Event
+    {
+      std::uint64_t timestamp; /**< The time of the event in ns since the tracer was created. */
+      unsigned name; /**< The ID of the option, state, or track name. 0 if there is none. */
+      char phase; /**< 'B' for option begins, 'E' for option ends, 'i' for state transitions, 'M' for track names. */
+    };
+
+    /** Events handed over to the writer thread. */
+    struct Batch
+    {
+      unsigned thread; /**< The number of the buffer the events were recorded in. */
+      std::vector<Event> events; /**< The events. */
+    };
+
+    std::ofstream stream; /**< The file the trace is written to. Only used by the writer thread while it runs. */
+    std::vector<std::string> writtenNames; /**< The copy of `names` used by the writer thread. */
+    bool first = true; /**< Was no event written yet? Only used by the writer thread while it runs. */
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); /**< The time the trace started. */
+    std::mutex mutex; /**< Protects all members below. */
+    std::condition_variable condition; /**< Wakes up the writer thread. */
+    std::vector<Batch> queue; /**< Batches not written yet. */
+    std::vector<std::string> names = {""}; /**< All names, indexed by their IDs. */
+    std::unordered_map<std::string, unsigned> ids; /**< The IDs of all names. */
+    unsigned threads = 0; /**< The number of buffers created so far. */
+    bool stop = false; /**< Should the writer thread terminate? */
+    std::thread writer; /**< The thread writing the events. Started last. */
+
+    /**
+     * Writes a text as JSON string, i.e. in quotes and with quotes and
+     * backslashes escaped.
+     * @param stream The stream the text is written to.
+     * @param text The text.
+     */
+    static void writeString(std::ostream& stream, const std::string& text)
+    {
+      stream << '"';
+      for(const char c : text)
+      {
+        if(c == '"' || c == '\\')
+          stream << '\\';
+        stream << c;
+      }
+      stream << '"';
+    }
+
+    /**
+     * Writes a single event to the file.
+     * @param event The event.
+     * @param thread The number of the buffer the event was recorded in.
+     */
+    void write(const Event& event, unsigned thread)
+    {
+      stream << (first ? "\n" : ",\n");
+      first = false;
+      if(event.phase == 'M')
+      {
+        stream << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+        writeString(stream, writtenNames[event.name]);
+        stream << "}}";
+        return;
+      }
+      stream << "{\"ph\":\"" << event.phase << "\",\"ts\":" << event.timestamp / 1000
+             << '.' << static_cast<char>('0' + event.timestamp / 100 % 10) << static_cast<char>('0' + event.timestamp / 10 % 10)
+             << static_cast<char>('0' + event.timestamp % 10) << ",\"pid\":1,\"tid\":" << thread;
+      if(event.phase == 'E')
+      {
+        if(event.name)
+        {
+          stream << ",\"args\":{\"state\":";
+          writeString(stream, writtenNames[event.name]);
+          stream << '}';
+        }
+      }
+      else
+      {
+        stream << (event.phase == 'i' ? ",\"s\":\"t\",\"cat\":\"state\",\"name\":" : ",\"cat\":\"option\",\"name\":");
+        writeString(stream, writtenNames[event.name]);
+      }
+      stream << '}';
+    }
+
+    /**
+     * The main loop of the writer thread. Only taking over the batches and the
+     * new names is done while locked, so behaviors handing over their buffers
+     * never wait for the file.
+     */
+    void run()
+    {
+      std::vector<Batch> batches;
+      while(true)
+      {
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          condition.wait(lock, [this] {return stop || !queue.empty();});
+          if(queue.empty())
+            return;
+          batches.swap(queue);
+          writtenNames.insert(writtenNames.end(), names.begin() + writtenNames.size(), names.end());
+        }
+        for(const Batch& batch : batches)
+          for(const Event& event : batch.events)
+            write(event, batch.thread);
+        batches.clear();
+        stream.flush();
+      }
+    }
+
+    /**
+     * Returns the ID of a name. Names are registered when they are seen for the first time.
+     * @param name The name.
+     * @return The ID of the name.
+     */
+    unsigned intern(const char* name)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto [entry, added] = ids.emplace(name, static_cast<unsigned>(names.size()));
+      if(added)
+        names.emplace_back(name);
+      return entry->second;
+    }
+
+  public:
+    /**
+     * A buffer for the events of a single thread. Typically, each behavior
+     * instance has its own one, which is then shown as a separate track.
+     */
+    class Buffer
+    {
+      Tracer& tracer; /**< The tracer the events are handed over to. */
+      unsigned thread; /**< The number of this buffer in the trace. */
+      std::size_t capacity; /**< The number of events after which the buffer is handed over at the end of a frame. */
+      std::vector<Event> events; /**< The events recorded since the last hand-over. */
+      std::unordered_map<const char*, unsigned> ids; /**< Cache for the IDs of names, indexed by their addresses. */
+
+      /**
+       * Returns the ID of a name without locking the tracer if it was used before.
+       * @param name The name.
+       * @return The ID of the name. 0 if there is no name.
+       */
+      unsigned intern(const char* name)
+      {
+        if(!name)
+          return 0;
+        auto entry = ids.find(name);
+        if(entry == ids.end())
+          entry = ids.emplace(name, tracer.intern(name)).first;
+        return entry->second;
+      }
+
+      /**
+       * Adds an event.
+       * @param name The ID of the name.
+       * @param phase The kind of the event.
+       */
+      void add(unsigned name, char phase)
+      {
+        events.push_back({static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tracer.start).count()),
+                          name, phase});
+      }
+
+    public:
+      /**
+       * Constructor.
+       * @param tracer The tracer the events are handed over to.
+       * @param name The name of the track in the trace viewer. If empty, a number is shown.
+       * @param capacity The number of events after which the buffer is handed over at the
+       *                 end of a frame.
+       */
+      Buffer(Tracer& tracer, const std::string& name = "", std::size_t capacity = 4096) :
+        tracer(tracer), capacity(capacity)
+      {
+        events.reserve(capacity);
+        {
+          std::lock_guard<std::mutex> lock(tracer.mutex);
+          thread = ++tracer.threads;
+        }
+        if(!name.empty())
+          events.push_back({0, tracer.intern(name.c_str()), 'M'}); // handed over with the first batch
+      }
+
+      /** The destructor hands over all remaining events. */
+      ~Buffer()
+      {
+        flush();
+      }
+
+      /**
+       * Records that an option begins.
+       * @param option The name of the option.
+       */
+      void begin(const char* option)
+      {
+        add(intern(option), 'B');
+      }
+
+      /**
+       * Records that an option ends.
+       * @param state The name of the state the option ended in. Can be null.
+       */
+      void end(const char* state)
+      {
+        add(intern(state), 'E');
+      }
+
+      /**
+       * Records a state transition.
+       * @param state The name of the new state.
+       */
+      void transition(const char* state)
+      {
+        add(intern(state), 'i');
+      }
+
+      /** Called at the end of each frame. Hands over the events if the buffer is full. */
+      void endFrame()
+      {
+        if(events.size() >= capacity)
+          flush();
+      }
+
+      /** Hands over all events recorded to the writer thread. */
+      void flush()
+      {
+        if(!events.empty())
+        {
+          std::vector<Event> batch;
+          batch.reserve(capacity);
+          batch.swap(events);
+          {
+            std::lock_guard<std::mutex> lock(tracer.mutex);
+            tracer.queue.push_back({thread, std::move(batch)});
+          }
+          tracer.condition.notify_one();
+        }
+      }
+    };
+
+    /**
+     * The constructor opens the file and starts the writer thread.
+     * @param filename The name of the file the trace is written to.
+     */
+    Tracer(const std::string& filename) :
+      stream(filename)
+    {
+      stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+      writer = std::thread([this] {run();});
+    }
+
+    /** The destructor writes all remaining events and completes the file. */
+    ~Tracer()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+      }
+      condition.notify_one();
+      writer.join();
+      stream << "\n]}\n";
+    }
+  };
+}